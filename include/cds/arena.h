@@ -0,0 +1,103 @@
+#ifndef CDS_ARENA_GUARD_HEADER
+#define CDS_ARENA_GUARD_HEADER
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cds.h"
+
+/**
+ * Arena struct pointer.
+ *
+ * An arena hands out memory by bumping an offset inside big chunks, chunks
+ * are chained when one runs out and everything is released at once with
+ * cds_arena_reset or cds_arena_rewind.
+ *
+ * @since 1.1
+ */
+typedef struct cds_arena_i* cds_arena;
+
+/**
+ * Position inside an arena to rewind to.
+ *
+ * @see cds_arena_mark
+ * @since 1.1
+ */
+struct cds_arena_mark {
+    void* chunk;
+    size_t used;
+};
+
+/**
+ * Create a new arena.
+ *
+ * Chunks are taken from given memory manager, a chunk_size of 0 uses a
+ * default of 64 KiB.
+ *
+ * @param chunk_size bytes per chunk
+ * @param memory memory manager backing chunks
+ * @since 1.1
+ * @return new arena or NULL if could not be created
+ */
+cds_arena cds_arena_create(size_t chunk_size, struct cds_memory memory);
+/**
+ * Destroy an arena and every chunk it holds.
+ *
+ * Everything allocated from the arena becomes invalid.
+ *
+ * @param arena to be freed/destroyed
+ * @since 1.1
+ */
+void cds_arena_destroy(cds_arena arena);
+
+/**
+ * Release every allocation done in arena.
+ *
+ * Chunks are kept to be reused, so no allocator is called.
+ *
+ * @param arena to reset
+ * @since 1.1
+ */
+void cds_arena_reset(cds_arena arena);
+/**
+ * Take the current position of arena.
+ *
+ * @param arena to take position from
+ * @since 1.1
+ * @return mark to be used with cds_arena_rewind
+ */
+struct cds_arena_mark cds_arena_mark(cds_arena arena);
+/**
+ * Release every allocation done in arena after given mark.
+ *
+ * Mark should come from this arena and not be older than the last reset or
+ * a rewind to a previous mark.
+ *
+ * @param arena to rewind
+ * @param mark where to go back
+ * @since 1.1
+ */
+void cds_arena_rewind(cds_arena arena, struct cds_arena_mark mark);
+/**
+ * Check how many bytes are handed out by arena.
+ *
+ * @param arena to check
+ * @since 1.1
+ * @return bytes in use, headers and padding included
+ */
+size_t cds_arena_used(cds_arena arena);
+
+/**
+ * Memory manager allocating from an arena.
+ *
+ * Deallocating is a no-op unless it is the last allocation, reallocating the
+ * last allocation grows it in place when chunk has room. Blocks moved by
+ * reallocation keep the alignment they were allocated with.
+ *
+ * @param arena where memory comes from
+ * @since 1.1
+ * @return memory manager for arena
+ */
+struct cds_memory cds_memory_arena(cds_arena arena);
+
+#endif // CDS_ARENA_GUARD_HEADER
@@ -9,17 +9,22 @@
 #define CDS_OK 0
 #define CDS_ERR 1
 
-typedef void* (*cds_allocator)(size_t bytes);
-typedef void* (*cds_reallocator)(void* ptr, size_t bytes);
-typedef void (*cds_deallocator)(CDS_OBJ(T) src);
+typedef void* (*cds_allocator)(void* context, size_t bytes);
+typedef void* (*cds_reallocator)(void* context, void* ptr, size_t bytes);
+typedef void (*cds_deallocator)(void* context, CDS_OBJ(T) src);
+typedef void* (*cds_aligned_allocator)(void* context, size_t alignment, size_t bytes);
 
 struct cds_memory {
+    // user data given back to every call, i.e. an arena
+    void* context;
     // allocator for internal
     cds_allocator allocator;
     // realocator for internal
     cds_reallocator reallocator;
     // deallocator for internal
     cds_deallocator deallocator;
+    // allocator for over-aligned memory, optional, released by deallocator
+    cds_aligned_allocator aligned_allocator;
 };
 
 struct cds_memory cds_memory_system();
@@ -0,0 +1,118 @@
+#ifndef CDS_DSU_GUARD_HEADER
+#define CDS_DSU_GUARD_HEADER
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cds.h"
+
+/**
+ * Disjoint set union struct pointer.
+ *
+ * Elements are numbered from 0 and start in their own set. Sets are merged
+ * by rank and finds compress paths. Functions with _concurrent suffix are
+ * lock-free and may run from several threads at once, but they must not
+ * be mixed with the sequential ones without synchronization.
+ *
+ * @since 1.1
+ */
+typedef struct cds_dsu_i* cds_dsu;
+
+/**
+ * Create a new disjoint set union.
+ *
+ * @param size number of elements, up to 2^56
+ * @param memory memory manager
+ * @since 1.1
+ * @return new disjoint set union or NULL if could not be created
+ */
+cds_dsu cds_dsu_create(size_t size, struct cds_memory memory);
+/**
+ * Destroy a disjoint set union.
+ *
+ * @param dsu to be freed/destroyed
+ * @since 1.1
+ */
+void cds_dsu_destroy(cds_dsu dsu);
+
+/**
+ * Check how many elements there are.
+ *
+ * @param dsu to check
+ * @since 1.1
+ * @return number of elements
+ */
+size_t cds_dsu_size(cds_dsu dsu);
+/**
+ * Check how many sets there are.
+ *
+ * @param dsu to check
+ * @since 1.1
+ * @return number of sets
+ */
+size_t cds_dsu_sets(cds_dsu dsu);
+
+/**
+ * Find representative of the set holding an element.
+ *
+ * Every element on the path is linked straight to representative.
+ *
+ * @param dsu to search in
+ * @param element to find, must be lower than size
+ * @since 1.1
+ * @return representative element
+ */
+size_t cds_dsu_find(cds_dsu dsu, size_t element);
+/**
+ * Merge the sets holding two elements.
+ *
+ * Representative of lower rank set is linked under the other one.
+ *
+ * @param dsu to merge in
+ * @param a first element
+ * @param b second element
+ * @since 1.1
+ * @return true if sets were merged, false if they already were the same
+ */
+bool cds_dsu_union(cds_dsu dsu, size_t a, size_t b);
+/**
+ * Check if two elements are in the same set.
+ *
+ * @param dsu to search in
+ * @param a first element
+ * @param b second element
+ * @since 1.1
+ * @return true if they're in the same set
+ */
+bool cds_dsu_same(cds_dsu dsu, size_t a, size_t b);
+
+/**
+ * Find representative of the set holding an element, lock-free.
+ *
+ * Paths are halved with compare-and-swap, so it can run alongside
+ * cds_dsu_union_concurrent. While unions run, representative may change
+ * right after it's returned.
+ *
+ * @see cds_dsu_find
+ * @param dsu to search in
+ * @param element to find, must be lower than size
+ * @since 1.1
+ * @return representative element
+ */
+size_t cds_dsu_find_concurrent(cds_dsu dsu, size_t element);
+/**
+ * Merge the sets holding two elements, lock-free.
+ *
+ * Parent and rank share a word changed with compare-and-swap, roots are
+ * linked by rank then by index so concurrent unions never make a cycle.
+ *
+ * @see cds_dsu_union
+ * @param dsu to merge in
+ * @param a first element
+ * @param b second element
+ * @since 1.1
+ * @return true if this call merged the sets
+ */
+bool cds_dsu_union_concurrent(cds_dsu dsu, size_t a, size_t b);
+
+#endif // CDS_DSU_GUARD_HEADER
@@ -1,15 +1,634 @@
 #ifndef CDS_GRAPH_HEADER 
 #define CDS_GRAPH_HEADER
 
+#include <limits.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <cds/cds.h>
+#include <cds/iter.h>
+#include <cds/vector.h>
+
+// distance and parent of nodes not reached by a traversal
+#define CDS_GRAPH_UNREACHED UINT_MAX
 
 typedef struct cds_graph cds_graph;
 
+/**
+ * How a graph stores its edges.
+ *
+ * @since 1.1
+ */
+enum cds_graph_kind {
+    // adjacency bit matrix, see cds_create_graph
+    CDS_GRAPH_MATRIX,
+    // compressed sparse rows, see cds_create_csr_graph
+    CDS_GRAPH_CSR,
+    // a vector of neighbors per node, see cds_create_list_graph
+    CDS_GRAPH_LIST
+};
+
+/**
+ * Formats to read and write graphs.
+ *
+ * @since 1.1
+ */
+enum cds_graph_format {
+    // a "from to" line per edge, after a "# nodes N edges M" line
+    CDS_GRAPH_FORMAT_TEXT,
+    // a header with node and edge count, then edges as pairs of uint32_t
+    CDS_GRAPH_FORMAT_BINARY,
+    // graphviz digraph, it can only be written
+    CDS_GRAPH_FORMAT_DOT
+};
+
+/**
+ * Strategies to renumber nodes of a graph.
+ *
+ * @since 1.1
+ */
+enum cds_graph_order {
+    // reverse Cuthill-McKee, neighbors get close ids, small bandwidth
+    CDS_GRAPH_ORDER_RCM,
+    // highest in plus out degree first, hubs share cache lines
+    CDS_GRAPH_ORDER_DEGREE,
+    // breadth-first visiting order from lowest unvisited id
+    CDS_GRAPH_ORDER_BFS
+};
+
+/**
+ * Ways to pick next node of a random walk.
+ *
+ * @since 1.1
+ */
+enum cds_graph_walk {
+    // every out-edge is equally likely
+    CDS_GRAPH_WALK_UNIFORM,
+    // out-edges are picked in proportion to their weight
+    CDS_GRAPH_WALK_WEIGHTED,
+    // weighted and biased by previous node, see cds_graph_walk_config
+    CDS_GRAPH_WALK_NODE2VEC
+};
+
+/**
+ * Configuration for random walks.
+ *
+ * @since 1.1
+ */
+struct cds_graph_walk_config {
+    enum cds_graph_walk kind;
+    // nodes in every walk, start included, greater than 0
+    size_t length;
+    // walks starting at every node
+    size_t walks_per_node;
+    // node2vec return and in-out parameters, going back weighs 1 / p, going
+    // further from previous node 1 / q
+    double p;
+    double q;
+    // same seed gives same walks for any number of threads
+    uint64_t seed;
+    // threads to use, 0 for one per online CPU
+    size_t nthreads;
+};
+
+/**
+ * Directed edge for bulk builders.
+ *
+ * @since 1.1
+ */
+struct cds_edge {
+    unsigned int from;
+    unsigned int to;
+};
 
+
+/**
+ * Create a graph as an adjacency matrix.
+ *
+ * Every edge is a single bit, rows are made of 64-bit words padded to a
+ * cache line and the whole matrix is one 64-byte aligned block, so it needs
+ * nodes * nodes / 8 bytes.
+ *
+ * @param nodes number of nodes
+ * @return new graph or NULL without memory
+ */
 cds_graph *cds_create_graph(int nodes);
 
+/**
+ * Create a graph in compressed sparse row form from an edge list.
+ *
+ * Edges are grouped by source with a prefix sum over out-degrees, every row
+ * is sorted and repeated edges are dropped. Memory is O(nodes + edges),
+ * neighbors of a node are contiguous and cds_has_edge is a binary search in
+ * its row. cds_add_edge works too, but it moves every later row, build
+ * graphs in bulk when possible.
+ *
+ * @param nodes number of nodes
+ * @param edges edge list, it's not modified
+ * @param count number of edges
+ * @since 1.1
+ * @return new graph or NULL if an edge is out of range or without memory
+ */
+cds_graph* cds_create_csr_graph(int nodes, const struct cds_edge* edges, size_t count);
+
+/**
+ * Create a graph keeping neighbors of every node in a vector.
+ *
+ * It's the backend for graphs that change: edges can be weighted, removed
+ * in O(degree) and nodes can be added with cds_add_node without rebuilding
+ * anything. Adding an edge appends to its row in amortized O(1) after a
+ * vectorized scan of the row for repeats, cds_add_edge_unchecked skips the
+ * scan. Rows are not ordered.
+ *
+ * @param nodes initial number of nodes
+ * @since 1.1
+ * @return new graph or NULL without memory
+ */
+cds_graph* cds_create_list_graph(int nodes);
+
+/**
+ * Add an edge with a weight.
+ *
+ * Only list graphs store weights, other graphs take the edge only if weight
+ * is 1.
+ *
+ * @param g graph
+ * @param from_node source of edge
+ * @param to_node target of edge
+ * @param weight edge weight
+ * @since 1.1
+ * @return true if edge was added, false if it exists or can't be stored
+ */
+bool cds_add_weighted_edge(cds_graph* g, unsigned int from_node, unsigned int to_node, double weight);
+/**
+ * Add an edge known not to be in graph.
+ *
+ * List graphs append it to its row in amortized O(1) without looking for
+ * repeats, adding an existing edge stores it twice. Other graphs behave as
+ * cds_add_weighted_edge.
+ *
+ * @param g graph
+ * @param from_node source of edge
+ * @param to_node target of edge, not yet a neighbor of from_node
+ * @param weight edge weight
+ * @since 1.1
+ * @return true if edge was added, false if it can't be stored
+ */
+bool cds_add_edge_unchecked(cds_graph* g, unsigned int from_node, unsigned int to_node, double weight);
+/**
+ * Remove an edge.
+ *
+ * It's O(1) on matrix graphs, O(degree) on list graphs and moves every later
+ * row on CSR graphs.
+ *
+ * @param g graph
+ * @param from_node source of edge
+ * @param to_node target of edge
+ * @since 1.1
+ * @return true if edge was removed, false if it doesn't exist
+ */
+bool cds_remove_edge(cds_graph* g, unsigned int from_node, unsigned int to_node);
+/**
+ * Get the weight of an edge, edges of unweighted graphs weigh 1.
+ *
+ * @param g graph
+ * @param from_node source of edge
+ * @param to_node target of edge
+ * @param out where weight is stored
+ * @since 1.1
+ * @return true if edge exists
+ */
+bool cds_edge_weight(cds_graph* g, unsigned int from_node, unsigned int to_node, double* out);
+/**
+ * Add a node without edges.
+ *
+ * List graphs grow in amortized O(1), CSR graphs reallocate their row
+ * offsets and matrix graphs have a fixed node count.
+ *
+ * @param g graph
+ * @since 1.1
+ * @return id of new node or -1 if it could not be added
+ */
+int cds_add_node(cds_graph* g);
+/**
+ * Count nodes of a graph.
+ *
+ * @param g graph
+ * @since 1.1
+ * @return number of nodes
+ */
+int cds_graph_nodes(cds_graph* g);
+
+/**
+ * Check how a graph stores its edges.
+ *
+ * @param g graph to check
+ * @since 1.1
+ * @return graph kind
+ */
+enum cds_graph_kind cds_graph_kind(cds_graph* g);
+
+/**
+ * Count edges leaving a node.
+ *
+ * @param g graph
+ * @param node node to check
+ * @since 1.1
+ * @return out-degree of node
+ */
+size_t cds_graph_out_degree(cds_graph* g, unsigned int node);
+
+/**
+ * Give back neighbors of a node in a CSR graph without copying them.
+ *
+ * Neighbors are sorted and pointer is valid until graph is modified.
+ *
+ * @param g CSR graph
+ * @param node node to check
+ * @param count where out-degree is stored
+ * @since 1.1
+ * @return first neighbor of node or NULL if graph is not a CSR one
+ */
+const unsigned int* cds_graph_csr_row(cds_graph* g, unsigned int node, size_t* count);
+
+/**
+ * Give back the row of a node in a matrix graph without copying it.
+ *
+ * Bit i % 64 of word i / 64 is set if there is an edge to node i, bits past
+ * last node are always clear.
+ *
+ * @param g matrix graph
+ * @param node node to check
+ * @param words where row length in words is stored
+ * @since 1.1
+ * @return row of node or NULL if graph is not a matrix one
+ */
+const uint64_t* cds_graph_matrix_row(cds_graph* g, unsigned int node, size_t* words);
+
+/**
+ * Keep only edges of dst_node going to a neighbor of src_node.
+ *
+ * Rows are combined a word at a time, graph must be a matrix one.
+ *
+ * @param g matrix graph
+ * @param dst_node node whose edges are changed
+ * @param src_node node whose edges are read
+ * @since 1.1
+ * @return new out-degree of dst_node
+ */
+size_t cds_graph_row_and(cds_graph* g, unsigned int dst_node, unsigned int src_node);
+/**
+ * Add to dst_node an edge to every neighbor of src_node.
+ *
+ * Rows are combined a word at a time, graph must be a matrix one.
+ *
+ * @param g matrix graph
+ * @param dst_node node whose edges are changed
+ * @param src_node node whose edges are read
+ * @since 1.1
+ * @return new out-degree of dst_node
+ */
+size_t cds_graph_row_or(cds_graph* g, unsigned int dst_node, unsigned int src_node);
+/**
+ * Count nodes both a_node and b_node have an edge to.
+ *
+ * Graph must be a matrix one, rows are not modified.
+ *
+ * @param g matrix graph
+ * @param a_node first node
+ * @param b_node second node
+ * @since 1.1
+ * @return number of common neighbors
+ */
+size_t cds_graph_common_neighbors(cds_graph* g, unsigned int a_node, unsigned int b_node);
+
+// Input/Output
+/**
+ * Write every edge of a graph to a file descriptor.
+ *
+ * Lines are rendered into a 1 MiB buffer without stdio and written in full
+ * blocks. Edge weights are not written.
+ *
+ * @param g graph to write
+ * @param fd open file descriptor
+ * @param format any cds_graph_format
+ * @since 1.1
+ * @return CDS_OK if everything was written otherwise CDS_ERR
+ */
+int cds_graph_write_fd(cds_graph* g, int fd, enum cds_graph_format format);
+/**
+ * Write every edge of a graph to a stdio stream.
+ *
+ * @see cds_graph_write_fd
+ * @param g graph to write
+ * @param file open stream, it's flushed
+ * @param format any cds_graph_format
+ * @since 1.1
+ * @return CDS_OK if everything was written otherwise CDS_ERR
+ */
+int cds_graph_write_file(cds_graph* g, FILE* file, enum cds_graph_format format);
+/**
+ * Save every edge of a graph to a file, replacing it.
+ *
+ * @see cds_graph_write_fd
+ * @param g graph to save
+ * @param path file to write
+ * @param format any cds_graph_format
+ * @since 1.1
+ * @return CDS_OK if it could be saved otherwise CDS_ERR
+ */
+int cds_graph_save_edgelist(cds_graph* g, const char* path, enum cds_graph_format format);
+/**
+ * Read an edge list from a file descriptor into a CSR graph.
+ *
+ * Input is parsed in 1 MiB chunks straight from read, nothing is allocated
+ * per line. Text lists may have comments starting with '#' or '%' and ids
+ * separated by spaces, tabs or commas; without a "# nodes N" line node count
+ * is largest id plus one.
+ *
+ * @see cds_create_csr_graph
+ * @param fd open file descriptor
+ * @param format CDS_GRAPH_FORMAT_TEXT or CDS_GRAPH_FORMAT_BINARY
+ * @since 1.1
+ * @return new graph or NULL if input is not valid or without memory
+ */
+cds_graph* cds_graph_read_fd(int fd, enum cds_graph_format format);
+/**
+ * Load an edge list from a file into a CSR graph.
+ *
+ * @see cds_graph_read_fd
+ * @param path file to read
+ * @param format CDS_GRAPH_FORMAT_TEXT or CDS_GRAPH_FORMAT_BINARY
+ * @since 1.1
+ * @return new graph or NULL if file is not valid or without memory
+ */
+cds_graph* cds_graph_load_edgelist(const char* path, enum cds_graph_format format);
+/**
+ * Save a graph as a snapshot that can be mapped back.
+ *
+ * Snapshot is CSR: a page-sized versioned header, then row offsets and
+ * sorted neighbors, each section page aligned. Graph is written to a
+ * temporary file next to path and renamed, processes with old snapshot
+ * mapped keep reading it.
+ *
+ * @param g graph to save, any backend
+ * @param path file to write
+ * @since 1.1
+ * @return CDS_OK if it could be saved otherwise CDS_ERR
+ */
+int cds_graph_save_snapshot(cds_graph* g, const char* path);
+/**
+ * Open a snapshot mapping its file read-only.
+ *
+ * Nothing is copied or built, pages are loaded on first access and shared by
+ * every process mapping the same file. Graph is a CSR graph: edge lookups,
+ * neighbor iterators and algorithms read the mapping directly, adding or
+ * removing edges and nodes always fails. Header and offsets are always
+ * checked in O(nodes), so every row lies inside the mapping. Without verify
+ * targets are not read: file must come from a trusted writer, as an out of
+ * range or unsorted target makes lookups and algorithms misbehave.
+ *
+ * @param path file written by cds_graph_save_snapshot
+ * @param verify check every row is sorted and in range, reads whole file
+ * @since 1.1
+ * @return new graph or NULL if file could not be mapped or is not valid
+ */
+cds_graph* cds_graph_open_mapped(const char* path, bool verify);
+/**
+ * Check if a graph can not be changed.
+ *
+ * @param g graph to check
+ * @since 1.1
+ * @return true if graph was opened with cds_graph_open_mapped
+ */
+bool cds_graph_readonly(cds_graph* g);
+
+// Iterators
+/**
+ * Create an iterator over successors of a node.
+ *
+ * Iterator yields pointers to unsigned int node ids and only visits real
+ * neighbors: matrix rows skip empty words and find set bits with ctz, CSR
+ * and list rows are walked in place. Cost is O(degree) on sparse backends
+ * and O(nodes / 64 + degree) on matrix ones. Graph must not change while
+ * iterating.
+ *
+ * @param g graph
+ * @param node node whose neighbors are visited
+ * @since 1.1
+ * @return iterator or NULL if could not be created
+ */
+CDS_ITER(unsigned int) cds_graph_neighbors(cds_graph* g, unsigned int node);
+/**
+ * Initialize an iterator over successors of a node in caller's memory.
+ *
+ * Nothing is allocated, iterator can be placed in the stack.
+ *
+ * @see cds_graph_neighbors
+ * @param iter to be initialized
+ * @param g graph
+ * @param node node whose neighbors are visited
+ * @since 1.1
+ */
+void cds_graph_neighbors_init(CDS_ITER(unsigned int) iter, cds_graph* g, unsigned int node);
+
+// Traversals
+/**
+ * Breadth-first search from a node, following edge direction.
+ *
+ * Search is direction-optimizing: small frontiers are expanded top-down from
+ * a queue, large ones bottom-up, with every unvisited node looking for a
+ * parent in a frontier bitmap. Levels are split between threads. Any node
+ * of the previous level may end up as parent of a node.
+ *
+ * @param g graph to traverse
+ * @param source node where search starts
+ * @param out_dist hop count per node or CDS_GRAPH_UNREACHED, can be NULL
+ * @param out_parent parent per node or CDS_GRAPH_UNREACHED, source is its own
+ * parent, can be NULL
+ * @param nthreads threads to use, 0 for one per online CPU
+ * @since 1.1
+ * @return CDS_OK if it could be traversed otherwise CDS_ERR
+ */
+int cds_graph_bfs(cds_graph* g, unsigned int source, unsigned int* out_dist, unsigned int* out_parent, size_t nthreads);
+
+// Components
+/**
+ * Label weakly connected components, edge direction is ignored.
+ *
+ * Every edge is a union in a disjoint set union (see cds_dsu). With several
+ * threads edges are split in disjoint ranges and merged with lock-free
+ * compare-and-swap unions. Labels are dense: components are numbered from 0
+ * in order of their lowest node, so their count is largest label plus one.
+ *
+ * @param g graph
+ * @param labels_out component per node
+ * @param nthreads threads to use, 0 for one per online CPU
+ * @since 1.1
+ * @return CDS_OK if components were labeled otherwise CDS_ERR
+ */
+int cds_graph_components(cds_graph* g, unsigned int* labels_out, size_t nthreads);
+
+// Ordering
+/**
+ * Label strongly connected components.
+ *
+ * Iterative Tarjan over an explicit stack, so deep graphs don't overflow call
+ * stack, runs in O(V + E). Labels follow topological order of condensed
+ * graph: an edge between two components always goes from lower label to
+ * higher one. Their count is largest label plus one.
+ *
+ * @param g graph
+ * @param labels_out component per node
+ * @since 1.1
+ * @return CDS_OK if components were labeled otherwise CDS_ERR
+ */
+int cds_graph_scc(cds_graph* g, unsigned int* labels_out);
+/**
+ * Sort nodes so that every edge goes forward.
+ *
+ * Kahn's algorithm in O(V + E), ready nodes are kept on a stack. When graph
+ * has a cycle only nodes not depending on it are written.
+ *
+ * @param g graph
+ * @param order_out nodes in topological order
+ * @since 1.1
+ * @return CDS_OK if graph is acyclic otherwise CDS_ERR
+ */
+int cds_graph_toposort(cds_graph* g, unsigned int* order_out);
+
+/**
+ * Renumber nodes so that neighbors are stored close to each other.
+ *
+ * Traversals follow edges in both directions, every component is visited.
+ * New graph has the same backend, edges and weights, only ids change: node
+ * old of g is perm_out[old] in new graph. Runs in O(V + E), plus sorting
+ * rows of CSR graphs and children of every node for RCM.
+ *
+ * @param g graph to renumber, left unchanged
+ * @param strategy any cds_graph_order
+ * @param perm_out new id of every node
+ * @since 1.1
+ * @return new graph or NULL without memory
+ */
+cds_graph* cds_graph_reorder(cds_graph* g, enum cds_graph_order strategy, unsigned int* perm_out);
+
+// Ranking
+/**
+ * Compute PageRank of every node.
+ *
+ * Power iteration on a pull sparse matrix-vector product: each node sums
+ * contributions of its in-neighbors, so workers own disjoint row ranges,
+ * balanced by edge count, and never write shared data. Rank of nodes without
+ * out-edges is spread over all nodes, scores add up to 1. Iteration stops
+ * once scores move less than tol in total (L1 norm), or after 1000 rounds.
+ *
+ * @param g graph
+ * @param damping probability of following an edge, in range [0, 1)
+ * @param tol convergence threshold, greater than 0
+ * @param nthreads threads to use, 0 for one per online CPU
+ * @param scores_out score per node
+ * @since 1.1
+ * @return CDS_OK if scores were computed otherwise CDS_ERR
+ */
+int cds_graph_pagerank(cds_graph* g, double damping, double tol, size_t nthreads, double* scores_out);
+
+// Random walks
+/**
+ * Generate random walks from every node.
+ *
+ * Walks are written round by round: walk i starts at node i % nodes and
+ * takes length ids from position i * length of walks_out, which is resized
+ * once to nodes * walks_per_node * length. Weighted steps use alias tables
+ * built once, so every step is O(1); node2vec steps sample a weighted
+ * candidate and keep it with probability given by p and q. Every walk has
+ * its own random stream, workers share nothing. Walks reaching a node
+ * without out-edges end there, their remaining ids are CDS_GRAPH_UNREACHED.
+ *
+ * @param g graph
+ * @param config walk configuration
+ * @param walks_out vector of unsigned int, reserve it to avoid reallocation
+ * @since 1.1
+ * @return CDS_OK if walks were generated otherwise CDS_ERR
+ */
+int cds_graph_random_walks(cds_graph* g, struct cds_graph_walk_config config, CDS_VECTOR(unsigned int) walks_out);
+
+// Triangles
+/**
+ * Count triangles of a graph.
+ *
+ * Edge direction is ignored, repeated edges and self loops don't count.
+ * Matrix graphs intersect neighbor sets with AND and popcount over packed
+ * rows, sparse ones with a SIMD merge of sorted neighbor arrays, each
+ * triangle is found once from its lowest node.
+ *
+ * @param g graph
+ * @param nthreads threads to use, 0 for one per online CPU
+ * @since 1.1
+ * @return number of triangles or SIZE_MAX if g is NULL or without memory
+ */
+size_t cds_graph_triangles(cds_graph* g, size_t nthreads);
+/**
+ * Compute local clustering coefficient of every node.
+ *
+ * Coefficient is triangles through a node over pairs of its neighbors, on
+ * the same undirected graph as cds_graph_triangles. Nodes with less than two
+ * neighbors get 0.
+ *
+ * @param g graph
+ * @param coefficients_out coefficient per node, in range [0, 1]
+ * @param nthreads threads to use, 0 for one per online CPU
+ * @since 1.1
+ * @return CDS_OK if coefficients were computed otherwise CDS_ERR
+ */
+int cds_graph_clustering(cds_graph* g, double* coefficients_out, size_t nthreads);
+
+// Shortest paths
+/**
+ * Weighted shortest paths from a node with Dijkstra's algorithm.
+ *
+ * Queue is a 4-ary heap whose children share a cache line. Edges of
+ * unweighted graphs weigh 1, so it works on any backend.
+ *
+ * @param g graph with non-negative weights
+ * @param source node where paths start
+ * @param dist_out distance per node or INFINITY, can be NULL
+ * @param pred_out predecessor per node or CDS_GRAPH_UNREACHED, source is its
+ * own predecessor, can be NULL
+ * @since 1.1
+ * @return CDS_OK if paths were found, CDS_ERR on a negative or NaN weight
+ */
+int cds_graph_sssp(cds_graph* g, unsigned int source, double* dist_out, unsigned int* pred_out);
+/**
+ * Weighted shortest paths from a node with parallel delta-stepping.
+ *
+ * Nodes are kept in buckets of width delta, every bucket is settled relaxing
+ * light edges (weight up to delta) in parallel until it empties, then heavy
+ * edges once. Distances are lowered with atomic compare-and-swap. Small
+ * graphs or a single thread fall back to cds_graph_sssp.
+ *
+ * @see cds_graph_sssp
+ * @param g graph with non-negative weights
+ * @param source node where paths start
+ * @param dist_out distance per node or INFINITY, can be NULL
+ * @param pred_out predecessor per node or CDS_GRAPH_UNREACHED, can be NULL
+ * @param delta bucket width, 0 for max weight over average out-degree
+ * @param nthreads threads to use, 0 for one per online CPU
+ * @since 1.1
+ * @return CDS_OK if paths were found, CDS_ERR on a negative or NaN weight
+ */
+int cds_graph_sssp_parallel(cds_graph* g, unsigned int source, double* dist_out, unsigned int* pred_out, double delta, size_t nthreads);
+
 void cds_destroy_graph(cds_graph* g);
 
+/**
+ * Print a graph in DOT format to stdout.
+ *
+ * @see cds_graph_write_file
+ * @param g graph to print
+ */
 void cds_print_graph(cds_graph* g);
 
 bool cds_add_edge(cds_graph* g, unsigned int from_node, unsigned int to_node);
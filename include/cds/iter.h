@@ -32,6 +32,33 @@
         block                                 \
     }
 
+/**
+ * Iterator loop until next element is NULL.
+ *
+ * It only takes one call per element, so it should be used with iterators
+ * which never yield NULL, such as container iterators.
+ *
+ * @param iter iterator to loop
+ * @param type iterator element type
+ * @param var element name in loop scope
+ * @param block function/lambda style to execute
+ * @since 1.1
+ */
+#define CDS_ITER_EACH(iter, type, var, block)      \
+    for (void* _iter_each_ = cds_iter_next(iter);  \
+         _iter_each_ != NULL;                      \
+         _iter_each_ = cds_iter_next(iter)) {      \
+        type var = _iter_each_;                    \
+        block                                      \
+    }
+
+/**
+ * Bytes reserved inside an iterator to keep container state.
+ *
+ * @since 1.1
+ */
+#define CDS_ITER_STATE 32
+
 /**
  * Iterator struct pointer.
  *
@@ -40,16 +67,18 @@
 typedef struct cds_iter_i* cds_iter;
 
 /**
- * Configuration for iterators.
+ * Operations of an iterator.
  *
- * @since 1.0
+ * Containers keep a static const instance and share it between all their
+ * iterators.
+ *
+ * @since 1.1
  */
-struct cds_iter_config {
-    struct cds_memory memory;
-    void* initial_data;
-
+struct cds_iter_vtable {
     bool (*has_next)(void* structure, void** data);
     void* (*next)(void* structure, void** data);
+    // optional, next run of contiguous elements, up to max of them
+    size_t (*next_batch)(void* structure, void** data, void** out, size_t max);
 
     bool (*has_back)(void* structure, void** data);
     void* (*back)(void* structure, void** data);
@@ -61,6 +90,39 @@ struct cds_iter_config {
     void (*destroy)(void* structure, void* data);
 };
 
+/**
+ * Iterator.
+ *
+ * It can live in the stack, see cds_iter_init, so no memory is allocated to
+ * iterate.
+ *
+ * @since 1.1
+ */
+struct cds_iter_i {
+    const struct cds_iter_vtable* vtable;
+    void* structure;
+    void* data;
+
+    // memory which allocated this iterator, if owned
+    struct cds_memory memory;
+    bool owned;
+
+    // inline state for containers, data can point here
+    _Alignas(max_align_t) unsigned char state[CDS_ITER_STATE];
+};
+
+/**
+ * Configuration for iterators.
+ *
+ * @since 1.0
+ */
+struct cds_iter_config {
+    struct cds_memory memory;
+    void* initial_data;
+
+    const struct cds_iter_vtable* vtable;
+};
+
 /**
  * Create a new iterator from structure and configuration.
  *
@@ -70,6 +132,18 @@ struct cds_iter_config {
  * @return new iterator or NULL if could not be created
  */
 CDS_ITER(T) cds_iter_create(void* structure, struct cds_iter_config config);
+/**
+ * Initialize an iterator in caller's memory, i.e. in the stack.
+ *
+ * Iterator is not owned, so cds_iter_destroy will not free it.
+ *
+ * @param iter to be initialized
+ * @param structure where iterator comes from
+ * @param vtable iterator operations
+ * @param data iterator data
+ * @since 1.1
+ */
+void cds_iter_init(CDS_ITER(T) iter, void* structure, const struct cds_iter_vtable* vtable, void* data);
 /**
  * Check if iterator still is valid.
  *
@@ -81,6 +155,8 @@ bool cds_iter_valid(CDS_ITER(T) iter);
 /**
  * Destroy an iterator.
  *
+ * Iterators made by cds_iter_init are only released, not freed.
+ *
  * @param iter to be freed/destroyed
  * @since 1.0
  */
@@ -123,6 +199,22 @@ bool cds_iter_hasnext(CDS_ITER(T) iter);
  * @return pointer to element or NULL if there is no
  */
 CDS_OBJ(T) cds_iter_next(CDS_ITER(T) iter);
+/**
+ * Fetch next elements which lie contiguous in memory.
+ *
+ * Elements are consumed as with cds_iter_next, out points to the first one
+ * and the rest follow it, so they can be processed in a tight loop. How many
+ * come at once depends on container: vectors give all remaining elements
+ * in one call, iterators without contiguous storage one per call. It only
+ * returns 0 once there are no elements left.
+ *
+ * @param iter iterator to fetch from
+ * @param out first element of the run
+ * @param max most elements to fetch, SIZE_MAX for no limit
+ * @since 1.1
+ * @return number of elements in the run
+ */
+size_t cds_iter_next_batch(CDS_ITER(T) iter, CDS_OBJ(T)* out, size_t max);
 
 /**
  * Check if iterator has more elements to be scanned in reverse.
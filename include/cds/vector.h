@@ -18,6 +18,13 @@
  */
 #define CDS_VECTOR(type) cds_vector
 
+/**
+ * Position returned when an element is not found.
+ *
+ * @since 1.1
+ */
+#define CDS_VECTOR_NPOS SIZE_MAX
+
 /**
  * Create a new vector.
  *
@@ -25,7 +32,7 @@
  * @param ... optional parameters in struct cds_vector_config
  * @since 1.0
  */
-#define CDS_VECTOR_NEW(dtype, ...) cds_vector_create((struct cds_vector_config){.type = sizeof(dtype), .capacity = 8, .memory = cds_memory_system(cds_memory_system()), __VA_ARGS__});
+#define CDS_VECTOR_NEW(dtype, ...) cds_vector_create((struct cds_vector_config){.type = sizeof(dtype), .capacity = 8, .memory = cds_memory_system(), __VA_ARGS__})
 /**
  * Loop vector with iterators.
  *
@@ -35,12 +42,109 @@
  * @param block function/lambda style
  * @since 1.0
  */
-#define CDS_VECTOR_LOOP(vector, type, var, block) {                     \
-    cds_iter _vector_iter_2022042512330000_ = cds_vector_begin(vector); \
-    CDS_ITER_LOOP(_vector_iter_2022042512330000_, type, var, block)     \
-    cds_iter_destroy(_vector_iter_2022042512330000_);                   \
+#define CDS_VECTOR_LOOP(vector, type, var, block) {                          \
+    struct cds_iter_i _vector_iter_2022042512330000_;                        \
+    cds_vector_iter_init(&_vector_iter_2022042512330000_, vector);           \
+    CDS_ITER_EACH(&_vector_iter_2022042512330000_, type, var, block)         \
 }
 
+/**
+ * Define a vector specialized for an element type.
+ *
+ * It generates a handle type called name, sharing layout with cds_vector, and
+ * static inline functions with the element size known at compile time:
+ *  - name##_create(capacity), name##_destroy(vector)
+ *  - name##_push(vector, value), name##_pop(vector, out)
+ *  - name##_at(vector, pos), name##_set(vector, pos, value)
+ *  - name##_data(vector), name##_size(vector)
+ *  - name##_vector(vector) to use it with any cds_vector function
+ *
+ * name##_at and name##_set do not check bounds, name##_push and name##_set
+ * must not be used on read-only mapped vectors.
+ *
+ * @param dtype element type
+ * @param name prefix for type and functions
+ * @since 1.1
+ */
+#define CDS_VECTOR_DEFINE(dtype, name)                                         \
+    typedef struct name##_i { struct cds_vector_i base; }* name;               \
+                                                                               \
+    static inline name name##_create(size_t capacity) {                        \
+        return (name) cds_vector_create((struct cds_vector_config) {           \
+            .type = sizeof(dtype),                                             \
+            .capacity = capacity,                                              \
+            .memory = cds_memory_system()                                      \
+        });                                                                    \
+    }                                                                          \
+    static inline void name##_destroy(name vector) {                           \
+        cds_vector_destroy((cds_vector) vector);                               \
+    }                                                                          \
+    static inline cds_vector name##_vector(name vector) {                      \
+        return (cds_vector) vector;                                            \
+    }                                                                          \
+    static inline int name##_push(name vector, dtype value) {                  \
+        struct cds_vector_i* base = &vector->base;                             \
+        if (base->size == base->reserved && cds_vector_grow(base, 1) != CDS_OK) { \
+            return CDS_ERR;                                                    \
+        }                                                                      \
+        ((dtype*) base->data)[base->size++] = value;                           \
+        base->mod++;                                                           \
+        return CDS_OK;                                                         \
+    }                                                                          \
+    static inline int name##_pop(name vector, dtype* out) {                    \
+        struct cds_vector_i* base = &vector->base;                             \
+        if (base->size == 0) {                                                 \
+            return CDS_ERR;                                                    \
+        }                                                                      \
+        base->size--;                                                          \
+        base->mod++;                                                           \
+        if (out != NULL) {                                                     \
+            *out = ((dtype*) base->data)[base->size];                          \
+        }                                                                      \
+        return CDS_OK;                                                         \
+    }                                                                          \
+    static inline dtype name##_at(name vector, size_t pos) {                   \
+        return ((dtype*) vector->base.data)[pos];                              \
+    }                                                                          \
+    static inline void name##_set(name vector, size_t pos, dtype value) {      \
+        ((dtype*) vector->base.data)[pos] = value;                             \
+    }                                                                          \
+    static inline dtype* name##_data(name vector) {                            \
+        return (dtype*) vector->base.data;                                     \
+    }                                                                          \
+    static inline size_t name##_size(name vector) {                            \
+        return vector->base.size;                                              \
+    }
+
+/**
+ * Vector struct.
+ *
+ * It's public so inline specializations can reach it, see CDS_VECTOR_DEFINE,
+ * fields should not be modified directly.
+ *
+ * @since 1.1
+ */
+struct cds_vector_i {
+    size_t size;
+    size_t reserved;
+    size_t type;
+
+    size_t mod;
+    size_t reallocs;
+
+    double growth_factor;
+    size_t min_capacity;
+    size_t shrink_threshold;
+    bool never_shrink;
+
+    size_t alignment;
+    bool huge_pages;
+    uint8_t storage;
+
+    struct cds_memory memory;
+    uint8_t* data;
+};
+
 /**
  * Vector struct pointer.
  *
@@ -60,6 +164,20 @@ struct cds_vector_config {
     size_t capacity;
     // memory manager
     struct cds_memory memory;
+
+    // capacity multiplier when full, greater than 1, 0 uses 2
+    double growth_factor;
+    // capacity never goes below it, 0 uses 8
+    size_t min_capacity;
+    // shrink once capacity is this many times the size, 0 uses 4
+    size_t shrink_threshold;
+    // never shrink on erase/pop back, only cds_vector_shrink does
+    bool never_shrink;
+
+    // data alignment in bytes, power of two, 0 uses allocator's default
+    size_t alignment;
+    // map buffers of 2 MiB or more on huge pages, bypassing memory manager
+    bool huge_pages;
 };
 
 // Constructor/Descontructor
@@ -104,6 +222,59 @@ CDS_VECTOR(T) cds_vector_from(CDS_VECTOR(T) vector, CDS_ITER(T) begin, CDS_ITER(
  */
 void cds_vector_destroy(CDS_VECTOR(T) vector);
 
+// Persistence
+/**
+ * Modes to open a saved vector, CDS_VECTOR_MAP_VERIFY can be combined with
+ * any of the others.
+ *
+ * @since 1.1
+ */
+enum cds_vector_map {
+    // pages are shared with file and can not be written
+    CDS_VECTOR_MAP_READ = 0,
+    // pages are copied on first write, file is never modified
+    CDS_VECTOR_MAP_COPY = 1,
+    // check data against saved checksum, it reads whole file
+    CDS_VECTOR_MAP_VERIFY = 2
+};
+
+/**
+ * Save vector elements into a file.
+ *
+ * File has a page-sized header with element size, count, alignment and a
+ * checksum, followed by raw elements in native byte order. Elements are
+ * written to a temporary file next to path and renamed, so an existing file
+ * is replaced atomically.
+ *
+ * @param vector to save
+ * @param path file to write
+ * @since 1.1
+ * @return CDS_OK if it could be saved otherwise CDS_ERR
+ */
+int cds_vector_save(CDS_VECTOR(T) vector, const char* path);
+/**
+ * Open a saved vector mapping its file into memory.
+ *
+ * Nothing is copied, pages are loaded on first access. Element access and
+ * iterators work as with any vector. Vectors opened with CDS_VECTOR_MAP_READ
+ * reject every operation writing elements, with CDS_VECTOR_MAP_COPY elements
+ * can be changed and once vector grows they move to system memory.
+ *
+ * @param path file written by cds_vector_save
+ * @param mode one of cds_vector_map values
+ * @since 1.1
+ * @return new vector or NULL if file could not be mapped or is not valid
+ */
+CDS_VECTOR(T) cds_vector_open_mapped(const char* path, int mode);
+/**
+ * Check if vector elements can not be written.
+ *
+ * @param vector to check
+ * @since 1.1
+ * @return true if vector was opened with CDS_VECTOR_MAP_READ
+ */
+bool cds_vector_readonly(CDS_VECTOR(T) vector);
+
 // Element Access
 /**
  * Copy an element from vector in given position.
@@ -152,6 +323,28 @@ int cds_vector_front(CDS_VECTOR(T) vector, CDS_OBJ(T) out);
  */
 int cds_vector_back(CDS_VECTOR(T) vector, CDS_OBJ(T) out);
 
+/**
+ * Get a pointer to an element from vector in given position.
+ *
+ * Pointer is valid until vector changes its capacity.
+ *
+ * @param vector to look in
+ * @param pos position to take, in range [0, size)
+ * @since 1.1
+ * @return pointer to element or NULL if there is no
+ */
+CDS_OBJ(T) cds_vector_ptr_at(CDS_VECTOR(T) vector, size_t pos);
+/**
+ * Get a pointer to the underlying contiguous buffer.
+ *
+ * Pointer is valid until vector changes its capacity.
+ *
+ * @param vector to look in
+ * @since 1.1
+ * @return pointer to first element or NULL if vector is NULL
+ */
+CDS_OBJ(T) cds_vector_data(CDS_VECTOR(T) vector);
+
 // iterators
 /**
  * Create a new iterator for this vector from beginning.
@@ -186,6 +379,27 @@ CDS_ITER(T) cds_vector_end(CDS_VECTOR(T) vector);
  */
 CDS_ITER(T) cds_vector_rend(CDS_VECTOR(T) vector);
 
+/**
+ * Initialize an iterator from beginning in caller's memory.
+ *
+ * Nothing is allocated, iterator can be placed in the stack and it does not
+ * need to be destroyed.
+ *
+ * @param iter to be initialized
+ * @param vector to iterate in
+ * @since 1.1
+ */
+void cds_vector_iter_init(CDS_ITER(T) iter, CDS_VECTOR(T) vector);
+/**
+ * Initialize an iterator from beginning in reverse mode in caller's memory.
+ *
+ * @see cds_vector_iter_init
+ * @param iter to be initialized
+ * @param vector to iterate in
+ * @since 1.1
+ */
+void cds_vector_riter_init(CDS_ITER(T) iter, CDS_VECTOR(T) vector);
+
 // Capacity Operators
 /**
  * Check if vector is empty.
@@ -215,6 +429,18 @@ size_t cds_vector_size(CDS_VECTOR(T) vector);
  * @return CDS_OK if it could reverse said capacity otherwise CDS_ERR
  */
 int cds_vector_reserve(CDS_VECTOR(T) vector, size_t capacity);
+/**
+ * Reserve room for count more elements following growth policy.
+ *
+ * Unlike cds_vector_reserve, capacity keeps growing geometrically, so calling
+ * it before each push back is amortized O(1).
+ *
+ * @param vector to increase capacity
+ * @param count how many more elements should fit
+ * @since 1.1
+ * @return CDS_OK if it could reserve room otherwise CDS_ERR
+ */
+int cds_vector_grow(CDS_VECTOR(T) vector, size_t count);
 /**
  * Check vector reserved size.
  *
@@ -223,6 +449,16 @@ int cds_vector_reserve(CDS_VECTOR(T) vector, size_t capacity);
  * @return reserved capacity in vector
  */
 size_t cds_vector_capacity(CDS_VECTOR(T) vector);
+/**
+ * Check how many times vector buffer has been reallocated.
+ *
+ * It counts growing and shrinking, useful to tune growth policy.
+ *
+ * @param vector to check
+ * @since 1.1
+ * @return number of reallocations
+ */
+size_t cds_vector_reallocs(CDS_VECTOR(T) vector);
 /**
  * Shrink vector to fit.
  *
@@ -279,10 +515,22 @@ int cds_vector_erase(CDS_VECTOR(T) vector, size_t pos);
  * @return CDS_OK if it could be pushed back otherwise CDS_ERR
  */
 int cds_vector_pushback(CDS_VECTOR(T) vector, CDS_OBJ(T) data);
+/**
+ * Push back an uninitialized element to vector.
+ *
+ * Element is built in place through returned pointer, which is valid until
+ * vector changes its capacity.
+ *
+ * @param vector to push back element in
+ * @since 1.1
+ * @return pointer to new element or NULL if could not be pushed back
+ */
+CDS_OBJ(T) cds_vector_emplace_back(CDS_VECTOR(T) vector);
 /**
  * Pop back an element from vector.
  *
- * If vector is empty, then it will fail.
+ * If vector is empty, then it will fail. Out can be NULL to only drop the
+ * element.
  *
  * @param vector to pop back element in
  * @param out output popped element
@@ -293,8 +541,8 @@ int cds_vector_popback(CDS_VECTOR(T) vector, CDS_OBJ(T) out);
 /**
  * Resize used size in vector.
  *
- * If count parameter is less than used size, then initializer can be
- * NULL safely
+ * New elements are copies of initializer, or zeroed if it is NULL. Growing or
+ * shrinking is done in a single pass.
  *
  * @param vector to resize
  * @param count new size to take
@@ -303,6 +551,46 @@ int cds_vector_popback(CDS_VECTOR(T) vector, CDS_OBJ(T) out);
  * @return CDS_OK if it could be resized otherwise CDS_ERR
  */
 int cds_vector_resize(CDS_VECTOR(T) vector, size_t count, CDS_OBJ(T) initializer);
+/**
+ * Push back count elements to vector.
+ *
+ * Elements are copied from a contiguous array, it should not point inside
+ * vector.
+ *
+ * @param vector to push back elements in
+ * @param data array with count elements
+ * @param count number of elements to be copied
+ * @since 1.1
+ * @return CDS_OK if they could be pushed back otherwise CDS_ERR
+ */
+int cds_vector_append_n(CDS_VECTOR(T) vector, CDS_OBJ(T) data, size_t count);
+/**
+ * Insert count elements in given position.
+ *
+ * Position should be in range [0, size], where size appends elements at the
+ * end. Elements are copied from a contiguous array, it should not point
+ * inside vector.
+ *
+ * @param vector to insert elements in
+ * @param pos position to take
+ * @param data array with count elements
+ * @param count number of elements to be copied
+ * @since 1.1
+ * @return CDS_OK if they could be inserted otherwise CDS_ERR
+ */
+int cds_vector_insert_range(CDS_VECTOR(T) vector, size_t pos, CDS_OBJ(T) data, size_t count);
+/**
+ * Erase elements in range [first, last).
+ *
+ * Range should be inside [0, size] otherwise it will fail.
+ *
+ * @param vector to erase elements in
+ * @param first first position to take out
+ * @param last position after the last one to take out
+ * @since 1.1
+ * @return CDS_OK if they could be erased otherwise CDS_ERR
+ */
+int cds_vector_erase_range(CDS_VECTOR(T) vector, size_t first, size_t last);
 /**
  * Swap two vector's elements to each other.
  *
@@ -315,4 +603,246 @@ int cds_vector_resize(CDS_VECTOR(T) vector, size_t count, CDS_OBJ(T) initializer
  */
 int cds_vector_swap(CDS_VECTOR(T) vector, CDS_VECTOR(T) other);
 
+// Search and reduction kernels
+/**
+ * Find first element equal to value in a vector of int32_t.
+ *
+ * Kernels scan data buffer directly, using the widest SIMD instructions the
+ * CPU supports (AVX-512, AVX2, SSE2) and a scalar loop otherwise. Vector
+ * element size should match the type or they fail.
+ *
+ * @param vector to look in
+ * @param value to look for
+ * @since 1.1
+ * @return position of element or CDS_VECTOR_NPOS if there is no
+ */
+size_t cds_vector_find_i32(CDS_VECTOR(int32_t) vector, int32_t value);
+/**
+ * Find first element equal to value in a vector of int64_t.
+ *
+ * @see cds_vector_find_i32
+ * @since 1.1
+ */
+size_t cds_vector_find_i64(CDS_VECTOR(int64_t) vector, int64_t value);
+/**
+ * Find first element equal to value in a vector of float.
+ *
+ * NaN is never equal to anything.
+ *
+ * @see cds_vector_find_i32
+ * @since 1.1
+ */
+size_t cds_vector_find_f32(CDS_VECTOR(float) vector, float value);
+/**
+ * Find first element equal to value in a vector of double.
+ *
+ * NaN is never equal to anything.
+ *
+ * @see cds_vector_find_i32
+ * @since 1.1
+ */
+size_t cds_vector_find_f64(CDS_VECTOR(double) vector, double value);
+
+/**
+ * Count elements equal to value in a vector of int32_t.
+ *
+ * @see cds_vector_find_i32
+ * @param vector to look in
+ * @param value to look for
+ * @since 1.1
+ * @return how many elements are equal to value
+ */
+size_t cds_vector_count_i32(CDS_VECTOR(int32_t) vector, int32_t value);
+/**
+ * Count elements equal to value in a vector of int64_t.
+ *
+ * @see cds_vector_count_i32
+ * @since 1.1
+ */
+size_t cds_vector_count_i64(CDS_VECTOR(int64_t) vector, int64_t value);
+/**
+ * Count elements equal to value in a vector of float.
+ *
+ * @see cds_vector_count_i32
+ * @since 1.1
+ */
+size_t cds_vector_count_f32(CDS_VECTOR(float) vector, float value);
+/**
+ * Count elements equal to value in a vector of double.
+ *
+ * @see cds_vector_count_i32
+ * @since 1.1
+ */
+size_t cds_vector_count_f64(CDS_VECTOR(double) vector, double value);
+
+/**
+ * Find smallest element in a vector of int32_t.
+ *
+ * It fails if vector is empty.
+ *
+ * @see cds_vector_find_i32
+ * @param vector to look in
+ * @param out output smallest element
+ * @since 1.1
+ * @return CDS_OK if it was success otherwise CDS_ERR
+ */
+int cds_vector_min_i32(CDS_VECTOR(int32_t) vector, int32_t* out);
+/**
+ * Find smallest element in a vector of int64_t.
+ *
+ * @see cds_vector_min_i32
+ * @since 1.1
+ */
+int cds_vector_min_i64(CDS_VECTOR(int64_t) vector, int64_t* out);
+/**
+ * Find smallest element in a vector of float.
+ *
+ * NaN elements are skipped, if all are NaN out is infinity.
+ *
+ * @see cds_vector_min_i32
+ * @since 1.1
+ */
+int cds_vector_min_f32(CDS_VECTOR(float) vector, float* out);
+/**
+ * Find smallest element in a vector of double.
+ *
+ * NaN elements are skipped, if all are NaN out is infinity.
+ *
+ * @see cds_vector_min_i32
+ * @since 1.1
+ */
+int cds_vector_min_f64(CDS_VECTOR(double) vector, double* out);
+
+/**
+ * Find biggest element in a vector of int32_t.
+ *
+ * It fails if vector is empty.
+ *
+ * @see cds_vector_find_i32
+ * @param vector to look in
+ * @param out output biggest element
+ * @since 1.1
+ * @return CDS_OK if it was success otherwise CDS_ERR
+ */
+int cds_vector_max_i32(CDS_VECTOR(int32_t) vector, int32_t* out);
+/**
+ * Find biggest element in a vector of int64_t.
+ *
+ * @see cds_vector_max_i32
+ * @since 1.1
+ */
+int cds_vector_max_i64(CDS_VECTOR(int64_t) vector, int64_t* out);
+/**
+ * Find biggest element in a vector of float.
+ *
+ * NaN elements are skipped, if all are NaN out is -infinity.
+ *
+ * @see cds_vector_max_i32
+ * @since 1.1
+ */
+int cds_vector_max_f32(CDS_VECTOR(float) vector, float* out);
+/**
+ * Find biggest element in a vector of double.
+ *
+ * NaN elements are skipped, if all are NaN out is -infinity.
+ *
+ * @see cds_vector_max_i32
+ * @since 1.1
+ */
+int cds_vector_max_f64(CDS_VECTOR(double) vector, double* out);
+
+/**
+ * Add all elements in a vector of int32_t.
+ *
+ * Sum is accumulated in 64 bits and wraps around on overflow.
+ *
+ * @see cds_vector_find_i32
+ * @param vector to look in
+ * @param out output sum, 0 for an empty vector
+ * @since 1.1
+ * @return CDS_OK if it was success otherwise CDS_ERR
+ */
+int cds_vector_sum_i32(CDS_VECTOR(int32_t) vector, int64_t* out);
+/**
+ * Add all elements in a vector of int64_t.
+ *
+ * @see cds_vector_sum_i32
+ * @since 1.1
+ */
+int cds_vector_sum_i64(CDS_VECTOR(int64_t) vector, int64_t* out);
+/**
+ * Add all elements in a vector of float.
+ *
+ * Sum is accumulated in double, in lanes, so rounding can differ from a
+ * sequential loop.
+ *
+ * @see cds_vector_sum_i32
+ * @since 1.1
+ */
+int cds_vector_sum_f32(CDS_VECTOR(float) vector, double* out);
+/**
+ * Add all elements in a vector of double.
+ *
+ * Sum is accumulated in lanes, so rounding can differ from a sequential loop.
+ *
+ * @see cds_vector_sum_i32
+ * @since 1.1
+ */
+int cds_vector_sum_f64(CDS_VECTOR(double) vector, double* out);
+
+// Sorting
+/**
+ * Key types for radix sort.
+ *
+ * @since 1.1
+ */
+enum cds_vector_key {
+    CDS_VECTOR_KEY_U32,
+    CDS_VECTOR_KEY_I32,
+    CDS_VECTOR_KEY_F32,
+    CDS_VECTOR_KEY_U64,
+    CDS_VECTOR_KEY_I64,
+    CDS_VECTOR_KEY_F64
+};
+
+/**
+ * Sort vector with a comparator, using one thread per online CPU.
+ *
+ * @see cds_vector_sort_parallel
+ * @param vector to sort
+ * @param cmp comparator like qsort one
+ * @since 1.1
+ * @return CDS_OK if it could be sorted otherwise CDS_ERR
+ */
+int cds_vector_sort(CDS_VECTOR(T) vector, int (*cmp)(const void*, const void*));
+/**
+ * Sort vector with a comparator in parallel.
+ *
+ * Each thread sorts a run and runs are merged pairwise, it needs a buffer as
+ * big as the vector. Sort is not stable and small vectors are sorted in
+ * caller's thread.
+ *
+ * @param vector to sort
+ * @param cmp comparator like qsort one, called from several threads
+ * @param nthreads threads to use, 0 for one per online CPU
+ * @since 1.1
+ * @return CDS_OK if it could be sorted otherwise CDS_ERR
+ */
+int cds_vector_sort_parallel(CDS_VECTOR(T) vector, int (*cmp)(const void*, const void*), size_t nthreads);
+/**
+ * Sort vector by a fixed-width key with a stable LSD radix sort.
+ *
+ * Key lives at offset bytes inside each element, so records can be sorted by
+ * a field. Digits where every key is equal are skipped. Floats are ordered
+ * like numbers, NaNs go to either end depending on their sign.
+ *
+ * @param vector to sort
+ * @param key type of key
+ * @param offset key position inside element
+ * @param nthreads threads to use, 0 for one per online CPU
+ * @since 1.1
+ * @return CDS_OK if it could be sorted otherwise CDS_ERR
+ */
+int cds_vector_radix_sort(CDS_VECTOR(T) vector, enum cds_vector_key key, size_t offset, size_t nthreads);
+
 #endif // CDS_VECTOR_GUARD_HEADER
@@ -0,0 +1,258 @@
+#include <stdint.h>
+#include <string.h>
+
+#include <cds/arena.h>
+
+#define _CDS_ARENA_ALIGN (_Alignof(max_align_t))
+#define _CDS_ARENA_ROUND(bytes) (((bytes) + _CDS_ARENA_ALIGN - 1) & ~(_CDS_ARENA_ALIGN - 1))
+// every block is preceded by its size and alignment
+#define _CDS_ARENA_HEADER _CDS_ARENA_ROUND(sizeof(size_t) * 2)
+#define _CDS_ARENA_CHUNK 65536
+
+struct cds_arena_chunk {
+    struct cds_arena_chunk* next;
+    size_t capacity;
+    size_t used;
+
+    _Alignas(max_align_t) uint8_t data[];
+};
+
+struct cds_arena_i {
+    struct cds_memory memory;
+    size_t chunk_size;
+
+    struct cds_arena_chunk* head;
+    struct cds_arena_chunk* current;
+    // last allocation, it can grow or be released in place
+    uint8_t* last;
+};
+
+static struct cds_arena_chunk* _cds_chunk_create(cds_arena arena, size_t capacity);
+static void* _cds_arena_bump(cds_arena arena, size_t alignment, size_t bytes);
+static void* _cds_arena_alloc(void* context, size_t bytes);
+static void* _cds_arena_aligned_alloc(void* context, size_t alignment, size_t bytes);
+static void* _cds_arena_realloc(void* context, void* ptr, size_t bytes);
+static void _cds_arena_free(void* context, void* ptr);
+
+cds_arena cds_arena_create(size_t chunk_size, struct cds_memory memory) {
+    if (!cds_memory_valid(memory)) {
+        return NULL;
+    }
+
+    cds_arena arena = memory.allocator(memory.context, sizeof(struct cds_arena_i));
+
+    if (arena != NULL) {
+        arena->memory = memory;
+        arena->chunk_size = chunk_size != 0 ? _CDS_ARENA_ROUND(chunk_size) : _CDS_ARENA_CHUNK;
+        arena->last = NULL;
+
+        arena->head = _cds_chunk_create(arena, arena->chunk_size);
+        arena->current = arena->head;
+
+        // no enough memory to create first chunk
+        if (arena->head == NULL) {
+            memory.deallocator(memory.context, arena);
+            arena = NULL;
+        }
+    }
+
+    return arena;
+}
+
+void cds_arena_destroy(cds_arena arena) {
+    if (arena == NULL) {
+        return;
+    }
+
+    struct cds_memory memory = arena->memory;
+    struct cds_arena_chunk* chunk = arena->head;
+
+    while (chunk != NULL) {
+        struct cds_arena_chunk* next = chunk->next;
+        memory.deallocator(memory.context, chunk);
+        chunk = next;
+    }
+
+    memory.deallocator(memory.context, arena);
+}
+
+void cds_arena_reset(cds_arena arena) {
+    if (arena == NULL) {
+        return;
+    }
+
+    arena->current = arena->head;
+    arena->current->used = 0;
+    arena->last = NULL;
+}
+
+struct cds_arena_mark cds_arena_mark(cds_arena arena) {
+    if (arena == NULL) {
+        return (struct cds_arena_mark) {0};
+    }
+
+    return (struct cds_arena_mark) {.chunk = arena->current, .used = arena->current->used};
+}
+
+void cds_arena_rewind(cds_arena arena, struct cds_arena_mark mark) {
+    if (arena == NULL) {
+        return;
+    }
+
+    if (mark.chunk == NULL) {
+        cds_arena_reset(arena);
+        return;
+    }
+
+    arena->current = mark.chunk;
+    arena->current->used = mark.used;
+    arena->last = NULL;
+}
+
+size_t cds_arena_used(cds_arena arena) {
+    if (arena == NULL) {
+        return 0;
+    }
+
+    size_t used = 0;
+    for (struct cds_arena_chunk* chunk = arena->head; chunk != arena->current; chunk = chunk->next) {
+        used += chunk->used;
+    }
+
+    return used + arena->current->used;
+}
+
+struct cds_memory cds_memory_arena(cds_arena arena) {
+    return (struct cds_memory) {
+        .context = arena,
+        .allocator = _cds_arena_alloc,
+        .reallocator = _cds_arena_realloc,
+        .deallocator = _cds_arena_free,
+        .aligned_allocator = _cds_arena_aligned_alloc
+    };
+}
+
+static struct cds_arena_chunk* _cds_chunk_create(cds_arena arena, size_t capacity) {
+    struct cds_memory* memory = &arena->memory;
+    struct cds_arena_chunk* chunk = memory->allocator(memory->context, sizeof(struct cds_arena_chunk) + capacity);
+
+    if (chunk != NULL) {
+        chunk->next = NULL;
+        chunk->capacity = capacity;
+        chunk->used = 0;
+    }
+
+    return chunk;
+}
+
+static void* _cds_arena_bump(cds_arena arena, size_t alignment, size_t bytes) {
+    if (bytes > SIZE_MAX - _CDS_ARENA_HEADER - _CDS_ARENA_ALIGN - alignment) {
+        return NULL;
+    }
+
+    // worst case padding to reach alignment after header
+    size_t padding = alignment - _CDS_ARENA_ALIGN;
+    size_t need = padding + _CDS_ARENA_HEADER + _CDS_ARENA_ROUND(bytes);
+    struct cds_arena_chunk* chunk = arena->current;
+
+    if (chunk->capacity - chunk->used < need) {
+        struct cds_arena_chunk* next = chunk->next;
+
+        // reuse chunks kept after a reset/rewind, otherwise chain a new one
+        if (next != NULL && next->capacity >= need) {
+            next->used = 0;
+        } else {
+            next = _cds_chunk_create(arena, need > arena->chunk_size ? need : arena->chunk_size);
+            if (next == NULL) {
+                return NULL;
+            }
+
+            next->next = chunk->next;
+            chunk->next = next;
+        }
+
+        arena->current = chunk = next;
+    }
+
+    uintptr_t address = (uintptr_t) &chunk->data[chunk->used + _CDS_ARENA_HEADER];
+    size_t offset = chunk->used + (alignment - address % alignment) % alignment;
+
+    uint8_t* block = &chunk->data[offset];
+    memcpy(block, &bytes, sizeof(size_t));
+    memcpy(block + sizeof(size_t), &alignment, sizeof(size_t));
+    chunk->used = offset + _CDS_ARENA_HEADER + _CDS_ARENA_ROUND(bytes);
+
+    arena->last = block + _CDS_ARENA_HEADER;
+    return arena->last;
+}
+
+static void* _cds_arena_alloc(void* context, size_t bytes) {
+    cds_arena arena = context;
+    if (arena == NULL) {
+        return NULL;
+    }
+
+    return _cds_arena_bump(arena, _CDS_ARENA_ALIGN, bytes);
+}
+
+static void* _cds_arena_aligned_alloc(void* context, size_t alignment, size_t bytes) {
+    cds_arena arena = context;
+    if (arena == NULL || alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        return NULL;
+    }
+
+    return _cds_arena_bump(arena, alignment > _CDS_ARENA_ALIGN ? alignment : _CDS_ARENA_ALIGN, bytes);
+}
+
+static void* _cds_arena_realloc(void* context, void* ptr, size_t bytes) {
+    cds_arena arena = context;
+    if (arena == NULL) {
+        return NULL;
+    }
+
+    if (ptr == NULL) {
+        return _cds_arena_alloc(context, bytes);
+    }
+
+    uint8_t* block = (uint8_t*) ptr - _CDS_ARENA_HEADER;
+    size_t size;
+    memcpy(&size, block, sizeof(size_t));
+
+    if (ptr == arena->last && bytes <= SIZE_MAX - _CDS_ARENA_HEADER - _CDS_ARENA_ALIGN) {
+        struct cds_arena_chunk* chunk = arena->current;
+        size_t begin = (size_t) (block - chunk->data);
+        size_t need = _CDS_ARENA_HEADER + _CDS_ARENA_ROUND(bytes);
+
+        // last allocation can grow or shrink in place
+        if (chunk->capacity - begin >= need) {
+            memcpy(block, &bytes, sizeof(size_t));
+            chunk->used = begin + need;
+            return ptr;
+        }
+    } else if (bytes <= size) {
+        memcpy(block, &bytes, sizeof(size_t));
+        return ptr;
+    }
+
+    // moved blocks keep alignment they were allocated with
+    size_t alignment;
+    memcpy(&alignment, block + sizeof(size_t), sizeof(size_t));
+
+    void* other = _cds_arena_bump(arena, alignment, bytes);
+    if (other != NULL) {
+        memcpy(other, ptr, size < bytes ? size : bytes);
+    }
+
+    return other;
+}
+
+static void _cds_arena_free(void* context, void* ptr) {
+    cds_arena arena = context;
+    if (arena == NULL || ptr == NULL || ptr != arena->last) {
+        return;
+    }
+
+    struct cds_arena_chunk* chunk = arena->current;
+    chunk->used = (size_t) ((uint8_t*) ptr - _CDS_ARENA_HEADER - chunk->data);
+    arena->last = NULL;
+}
@@ -2,11 +2,18 @@
 
 #include <cds/cds.h>
 
+static void* _cds_system_alloc(void* context, size_t bytes);
+static void* _cds_system_realloc(void* context, void* ptr, size_t bytes);
+static void _cds_system_free(void* context, void* ptr);
+static void* _cds_system_aligned_alloc(void* context, size_t alignment, size_t bytes);
+
 struct cds_memory cds_memory_system() {
     return (struct cds_memory) {
-        .allocator = malloc,
-        .reallocator = realloc,
-        .deallocator = free
+        .context = NULL,
+        .allocator = _cds_system_alloc,
+        .reallocator = _cds_system_realloc,
+        .deallocator = _cds_system_free,
+        .aligned_allocator = _cds_system_aligned_alloc
     };
 }
 
@@ -24,3 +31,25 @@ bool cds_memory_valid(struct cds_memory memory) {
     return true;
 }
 
+static void* _cds_system_alloc(void* context, size_t bytes) {
+    (void) context;
+    return malloc(bytes);
+}
+
+static void* _cds_system_realloc(void* context, void* ptr, size_t bytes) {
+    (void) context;
+    return realloc(ptr, bytes);
+}
+
+static void _cds_system_free(void* context, void* ptr) {
+    (void) context;
+    free(ptr);
+}
+
+static void* _cds_system_aligned_alloc(void* context, size_t alignment, size_t bytes) {
+    (void) context;
+
+    // aligned_alloc wants a size multiple of alignment
+    size_t rounded = (bytes + alignment - 1) / alignment * alignment;
+    return aligned_alloc(alignment, rounded != 0 ? rounded : alignment);
+}
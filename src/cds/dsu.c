@@ -0,0 +1,197 @@
+#include <stdint.h>
+
+#include <cds/dsu.h>
+
+// every element is a word, parent in low bits and rank in high ones
+#define _CDS_DSU_PARENT_BITS 56
+#define _CDS_DSU_PARENT_MASK ((UINT64_C(1) << _CDS_DSU_PARENT_BITS) - 1)
+#define _CDS_DSU_PARENT(word) ((size_t) ((word) & _CDS_DSU_PARENT_MASK))
+#define _CDS_DSU_RANK(word) ((word) >> _CDS_DSU_PARENT_BITS)
+#define _CDS_DSU_WORD(parent, rank) ((uint64_t) (parent) | ((uint64_t) (rank) << _CDS_DSU_PARENT_BITS))
+
+struct cds_dsu_i {
+    size_t size;
+    size_t sets;
+    struct cds_memory memory;
+
+    uint64_t* nodes;
+};
+
+static bool _cds_dsu_before(uint64_t a_word, size_t a, uint64_t b_word, size_t b);
+
+cds_dsu cds_dsu_create(size_t size, struct cds_memory memory) {
+    if (!cds_memory_valid(memory) || size > _CDS_DSU_PARENT_MASK || size > SIZE_MAX / sizeof(uint64_t)) {
+        return NULL;
+    }
+
+    cds_dsu dsu = memory.allocator(memory.context, sizeof(struct cds_dsu_i));
+    if (dsu == NULL) {
+        return NULL;
+    }
+
+    dsu->nodes = memory.allocator(memory.context, sizeof(uint64_t) * (size != 0 ? size : 1));
+    if (dsu->nodes == NULL) {
+        memory.deallocator(memory.context, dsu);
+        return NULL;
+    }
+
+    dsu->size = size;
+    dsu->sets = size;
+    dsu->memory = memory;
+
+    for (size_t element = 0; element < size; element++) {
+        dsu->nodes[element] = _CDS_DSU_WORD(element, 0);
+    }
+
+    return dsu;
+}
+
+void cds_dsu_destroy(cds_dsu dsu) {
+    if (dsu == NULL) {
+        return;
+    }
+
+    struct cds_memory memory = dsu->memory;
+
+    memory.deallocator(memory.context, dsu->nodes);
+    memory.deallocator(memory.context, dsu);
+}
+
+size_t cds_dsu_size(cds_dsu dsu) {
+    return dsu != NULL ? dsu->size : 0;
+}
+
+size_t cds_dsu_sets(cds_dsu dsu) {
+    return dsu != NULL ? __atomic_load_n(&dsu->sets, __ATOMIC_RELAXED) : 0;
+}
+
+size_t cds_dsu_find(cds_dsu dsu, size_t element) {
+    uint64_t* nodes = dsu->nodes;
+    size_t root = element;
+
+    while (_CDS_DSU_PARENT(nodes[root]) != root) {
+        root = _CDS_DSU_PARENT(nodes[root]);
+    }
+
+    // second pass links the whole path to root
+    while (element != root) {
+        size_t parent = _CDS_DSU_PARENT(nodes[element]);
+
+        nodes[element] = _CDS_DSU_WORD(root, _CDS_DSU_RANK(nodes[element]));
+        element = parent;
+    }
+
+    return root;
+}
+
+bool cds_dsu_union(cds_dsu dsu, size_t a, size_t b) {
+    uint64_t* nodes = dsu->nodes;
+    size_t a_root = cds_dsu_find(dsu, a);
+    size_t b_root = cds_dsu_find(dsu, b);
+
+    if (a_root == b_root) {
+        return false;
+    }
+
+    uint64_t a_word = nodes[a_root];
+    uint64_t b_word = nodes[b_root];
+
+    // a_root always becomes the child
+    if (!_cds_dsu_before(a_word, a_root, b_word, b_root)) {
+        size_t root = a_root;
+        uint64_t word = a_word;
+
+        a_root = b_root;
+        a_word = b_word;
+        b_root = root;
+        b_word = word;
+    }
+
+    nodes[a_root] = _CDS_DSU_WORD(b_root, _CDS_DSU_RANK(a_word));
+    if (_CDS_DSU_RANK(a_word) == _CDS_DSU_RANK(b_word)) {
+        nodes[b_root] = _CDS_DSU_WORD(b_root, _CDS_DSU_RANK(b_word) + 1);
+    }
+
+    dsu->sets--;
+    return true;
+}
+
+bool cds_dsu_same(cds_dsu dsu, size_t a, size_t b) {
+    return cds_dsu_find(dsu, a) == cds_dsu_find(dsu, b);
+}
+
+size_t cds_dsu_find_concurrent(cds_dsu dsu, size_t element) {
+    uint64_t* nodes = dsu->nodes;
+
+    while (true) {
+        uint64_t word = __atomic_load_n(&nodes[element], __ATOMIC_ACQUIRE);
+        size_t parent = _CDS_DSU_PARENT(word);
+
+        if (parent == element) {
+            return element;
+        }
+
+        // path halving, losing the race only means less compression
+        size_t grandparent = _CDS_DSU_PARENT(__atomic_load_n(&nodes[parent], __ATOMIC_ACQUIRE));
+        if (grandparent != parent) {
+            __atomic_compare_exchange_n(&nodes[element], &word, _CDS_DSU_WORD(grandparent, _CDS_DSU_RANK(word)),
+                false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+        }
+
+        element = grandparent;
+    }
+}
+
+bool cds_dsu_union_concurrent(cds_dsu dsu, size_t a, size_t b) {
+    uint64_t* nodes = dsu->nodes;
+
+    while (true) {
+        size_t a_root = cds_dsu_find_concurrent(dsu, a);
+        size_t b_root = cds_dsu_find_concurrent(dsu, b);
+
+        if (a_root == b_root) {
+            return false;
+        }
+
+        uint64_t a_word = __atomic_load_n(&nodes[a_root], __ATOMIC_ACQUIRE);
+        uint64_t b_word = __atomic_load_n(&nodes[b_root], __ATOMIC_ACQUIRE);
+
+        // a root was linked meanwhile, look again
+        if (_CDS_DSU_PARENT(a_word) != a_root || _CDS_DSU_PARENT(b_word) != b_root) {
+            continue;
+        }
+
+        if (!_cds_dsu_before(a_word, a_root, b_word, b_root)) {
+            size_t root = a_root;
+            uint64_t word = a_word;
+
+            a_root = b_root;
+            a_word = b_word;
+            b_root = root;
+            b_word = word;
+        }
+
+        // linking only lower (rank, index) under higher keeps it acyclic
+        if (!__atomic_compare_exchange_n(&nodes[a_root], &a_word, _CDS_DSU_WORD(b_root, _CDS_DSU_RANK(a_word)),
+            false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            continue;
+        }
+
+        // rank is only a hint, a lost race leaves it lower
+        if (_CDS_DSU_RANK(a_word) == _CDS_DSU_RANK(b_word)) {
+            __atomic_compare_exchange_n(&nodes[b_root], &b_word, _CDS_DSU_WORD(b_root, _CDS_DSU_RANK(b_word) + 1),
+                false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+        }
+
+        __atomic_fetch_sub(&dsu->sets, 1, __ATOMIC_RELAXED);
+        return true;
+    }
+}
+
+// order roots by rank, then by index
+static bool _cds_dsu_before(uint64_t a_word, size_t a, uint64_t b_word, size_t b) {
+    uint64_t a_rank = _CDS_DSU_RANK(a_word);
+    uint64_t b_rank = _CDS_DSU_RANK(b_word);
+
+    return a_rank < b_rank || (a_rank == b_rank && a < b);
+}
@@ -6,6 +6,7 @@ on how you're going to use the graph, space, implementation with before code, et
 
 Why use a adjacency matrix?, well is really easy to use, to represent and change nodes... 
 Just with the downside of space, when with have a graph with a lot of nodes but not many edges, the matrix will be really big.
+That's why every edge is a single bit, a row is made of 64-bit words and the whole matrix is one block.
 ----------------------------------------------------------------
 
 Define:
@@ -17,21 +18,22 @@ Define:
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 
-#include <cds/graph.h>
+#include <cds/vector.h>
 
-
-struct cds_graph {
-    int nodes;
-    bool **edges;
-};
+#include "graph_internal.h"
 
 
 // Function to create a graph, with the number of nodes
 cds_graph *cds_create_graph(int nodes) {
-    // Assign the size memory for the graph
-    cds_graph *g = malloc(sizeof(*g));
+    if (nodes < 0) {
+        return NULL;
+    }
+
+    // Assign the size memory for the graph, other backends fields are zeroed
+    cds_graph *g = calloc(1, sizeof(*g));
 
     // Check if g is null (maybe problems with the allocator)
     if (g == NULL){
@@ -40,68 +42,72 @@ cds_graph *cds_create_graph(int nodes) {
 
     // Add nodes and edges
     g -> nodes = nodes;
-    // Allocate the matrix
-    g -> edges = calloc(sizeof(bool*), g->nodes);
+    g -> kind = CDS_GRAPH_MATRIX;
+    // A bit per edge, every row starts in its own cache line
+    g -> words = _CDS_MATRIX_WORDS(nodes);
 
-    // Check if edges is null (just for check problems in memory)
-    if (g->edges == NULL){
+    size_t words = g->words * (size_t) nodes;
+    if (g->words != 0 && words / g->words != (size_t) nodes) {
         free(g);
         return NULL;
     }
 
+    // Allocate the matrix as a single block
+    g -> bits = aligned_alloc(_CDS_MATRIX_ALIGN, sizeof(uint64_t) * (words != 0 ? words : _CDS_MATRIX_LINE));
 
-    for (int i=0; i < g->nodes; i++) {
-        g->edges[i] = calloc(sizeof(bool), g->nodes);
-        if (g->edges[i] == NULL){
-            cds_destroy_graph(g);
-            return NULL;
-        }
+    // Check if bits is null (just for check problems in memory)
+    if (g->bits == NULL){
+        free(g);
+        return NULL;
     }
 
+    memset(g->bits, 0, sizeof(uint64_t) * words);
     return g; 
 }
 
 // Function to destroy a graph
 void cds_destroy_graph(cds_graph* g) {
-    // Check if the graph edges are NULL  
-    if (g == NULL || g->edges == NULL) {
+    if (g != NULL && g->kind == CDS_GRAPH_CSR) {
+        _cds_csr_destroy(g);
         return;
     }
 
+    if (g != NULL && g->kind == CDS_GRAPH_LIST) {
+        _cds_list_destroy(g);
+        return;
+    }
 
-    // Deleting all edges of the graph 
-    for (int i=0; i < g->nodes; i++) {
-        if  (g->edges[i] != NULL){
-            free(g->edges[i]);
-        }
+    // Check if the graph is NULL  
+    if (g == NULL) {
+        return;
     }
 
-    free(g->edges);
+    // Deleting all edges of the graph 
+    free(g->bits);
     // Delete the graph pointer
     free(g);
 }
 
 // Function to display the graph in memory
 void cds_print_graph(cds_graph* g) {
-    printf("digraph {\n");
-
-    // A for inside other to go through the matrix or array 2D 
-    for (int from=0; from < g->nodes; from++) {
-        for (int to=0; to < g->nodes; to++) {
-            if (g->edges[from][to]) {
-                printf("%d -> %d;\n", from, to);
-            }
-        }
-    }
-    printf("}\n");
+    // Edges are rendered in a buffer and written in big blocks
+    cds_graph_write_file(g, stdout, CDS_GRAPH_FORMAT_DOT);
 }
 
 // Function to add a edge to a graph
 bool cds_add_edge(cds_graph *g, unsigned int from_node, unsigned int to_node) {
     // Check for possible bugs
     assert(g != NULL);
-    assert(from_node < g->nodes);
-    assert(to_node < g->nodes);
+    assert(from_node < (unsigned int) g->nodes);
+    assert(to_node < (unsigned int) g->nodes);
+
+    if (g->kind == CDS_GRAPH_CSR) {
+        return _cds_csr_add_edge(g, from_node, to_node);
+    }
+
+    if (g->kind == CDS_GRAPH_LIST) {
+        return _cds_list_add_edge(g, from_node, to_node, 1, true);
+    }
 
     // If the edge already exists, return false
     if (cds_has_edge(g, from_node, to_node)) {
@@ -109,16 +115,255 @@ bool cds_add_edge(cds_graph *g, unsigned int from_node, unsigned int to_node) {
     }
 
     // Add the new edge
-    g->edges[from_node][to_node] = true;
+    _CDS_MATRIX_ROW(g, from_node)[to_node / 64] |= UINT64_C(1) << (to_node % 64);
     return true;
 }
 
 bool cds_has_edge(cds_graph *g, unsigned int from_node, unsigned int to_node) {
     // Check for possible bugs
     assert(g != NULL);
-    assert(from_node < g->nodes);
-    assert(to_node < g->nodes);
+    assert(from_node < (unsigned int) g->nodes);
+    assert(to_node < (unsigned int) g->nodes);
+
+    if (g->kind == CDS_GRAPH_CSR) {
+        return _cds_csr_has_edge(g, from_node, to_node);
+    }
+
+    if (g->kind == CDS_GRAPH_LIST) {
+        return _cds_list_has_edge(g, from_node, to_node);
+    }
 
     // return the edge if exists
-    return g->edges[from_node][to_node];
+    return (_CDS_MATRIX_ROW(g, from_node)[to_node / 64] >> (to_node % 64)) & 1;
+}
+
+bool cds_add_weighted_edge(cds_graph *g, unsigned int from_node, unsigned int to_node, double weight) {
+    assert(g != NULL);
+    assert(from_node < (unsigned int) g->nodes);
+    assert(to_node < (unsigned int) g->nodes);
+
+    if (g->kind == CDS_GRAPH_LIST) {
+        return _cds_list_add_edge(g, from_node, to_node, weight, true);
+    }
+
+    // Other backends only know unweighted edges
+    return weight == 1 && cds_add_edge(g, from_node, to_node);
+}
+
+bool cds_add_edge_unchecked(cds_graph *g, unsigned int from_node, unsigned int to_node, double weight) {
+    assert(g != NULL);
+    assert(from_node < (unsigned int) g->nodes);
+    assert(to_node < (unsigned int) g->nodes);
+
+    if (g->kind == CDS_GRAPH_LIST) {
+        // Caller promises the edge is new, so the row isn't scanned
+        return _cds_list_add_edge(g, from_node, to_node, weight, false);
+    }
+
+    return cds_add_weighted_edge(g, from_node, to_node, weight);
+}
+
+bool cds_remove_edge(cds_graph *g, unsigned int from_node, unsigned int to_node) {
+    assert(g != NULL);
+    assert(from_node < (unsigned int) g->nodes);
+    assert(to_node < (unsigned int) g->nodes);
+
+    if (g->kind == CDS_GRAPH_CSR) {
+        return _cds_csr_remove_edge(g, from_node, to_node);
+    }
+
+    if (g->kind == CDS_GRAPH_LIST) {
+        return _cds_list_remove_edge(g, from_node, to_node);
+    }
+
+    // If the edge doesn't exist, return false
+    if (!cds_has_edge(g, from_node, to_node)) {
+        return false;
+    }
+
+    _CDS_MATRIX_ROW(g, from_node)[to_node / 64] &= ~(UINT64_C(1) << (to_node % 64));
+    return true;
+}
+
+bool cds_edge_weight(cds_graph *g, unsigned int from_node, unsigned int to_node, double *out) {
+    assert(g != NULL);
+    assert(from_node < (unsigned int) g->nodes);
+    assert(to_node < (unsigned int) g->nodes);
+    assert(out != NULL);
+
+    if (g->kind == CDS_GRAPH_LIST) {
+        return _cds_list_weight(g, from_node, to_node, out);
+    }
+
+    if (!cds_has_edge(g, from_node, to_node)) {
+        return false;
+    }
+
+    *out = 1;
+    return true;
+}
+
+int cds_add_node(cds_graph *g) {
+    assert(g != NULL);
+
+    if (g->kind == CDS_GRAPH_LIST) {
+        return _cds_list_add_node(g);
+    }
+
+    if (g->kind == CDS_GRAPH_CSR) {
+        return _cds_csr_add_node(g);
+    }
+
+    // Matrix rows are as wide as the node count, they can't grow in place
+    return -1;
+}
+
+int cds_graph_nodes(cds_graph *g) {
+    assert(g != NULL);
+
+    return g->nodes;
+}
+
+enum cds_graph_kind cds_graph_kind(cds_graph *g) {
+    assert(g != NULL);
+
+    return g->kind;
+}
+
+size_t cds_graph_out_degree(cds_graph *g, unsigned int node) {
+    assert(g != NULL);
+    assert(node < (unsigned int) g->nodes);
+
+    if (g->kind == CDS_GRAPH_CSR) {
+        return g->offsets[node + 1] - g->offsets[node];
+    }
+
+    if (g->kind == CDS_GRAPH_LIST) {
+        return _cds_list_out_degree(g, node);
+    }
+
+    return _cds_bits_count(_CDS_MATRIX_ROW(g, node), g->words);
+}
+
+const unsigned int* cds_graph_csr_row(cds_graph *g, unsigned int node, size_t *count) {
+    assert(g != NULL);
+    assert(node < (unsigned int) g->nodes);
+    assert(count != NULL);
+
+    if (g->kind != CDS_GRAPH_CSR) {
+        *count = 0;
+        return NULL;
+    }
+
+    *count = g->offsets[node + 1] - g->offsets[node];
+    return &g->targets[g->offsets[node]];
+}
+
+const uint64_t* cds_graph_matrix_row(cds_graph *g, unsigned int node, size_t *words) {
+    assert(g != NULL);
+    assert(node < (unsigned int) g->nodes);
+    assert(words != NULL);
+
+    if (g->kind != CDS_GRAPH_MATRIX) {
+        *words = 0;
+        return NULL;
+    }
+
+    *words = g->words;
+    return _CDS_MATRIX_ROW(g, node);
+}
+
+size_t cds_graph_row_and(cds_graph *g, unsigned int dst_node, unsigned int src_node) {
+    assert(g != NULL);
+    assert(g->kind == CDS_GRAPH_MATRIX);
+    assert(dst_node < (unsigned int) g->nodes);
+    assert(src_node < (unsigned int) g->nodes);
+
+    uint64_t *dst = _CDS_MATRIX_ROW(g, dst_node);
+    const uint64_t *src = _CDS_MATRIX_ROW(g, src_node);
+
+    for (size_t word=0; word < g->words; word++) {
+        dst[word] &= src[word];
+    }
+
+    return _cds_bits_count(dst, g->words);
+}
+
+size_t cds_graph_row_or(cds_graph *g, unsigned int dst_node, unsigned int src_node) {
+    assert(g != NULL);
+    assert(g->kind == CDS_GRAPH_MATRIX);
+    assert(dst_node < (unsigned int) g->nodes);
+    assert(src_node < (unsigned int) g->nodes);
+
+    uint64_t *dst = _CDS_MATRIX_ROW(g, dst_node);
+    const uint64_t *src = _CDS_MATRIX_ROW(g, src_node);
+
+    for (size_t word=0; word < g->words; word++) {
+        dst[word] |= src[word];
+    }
+
+    return _cds_bits_count(dst, g->words);
+}
+
+size_t cds_graph_common_neighbors(cds_graph *g, unsigned int a_node, unsigned int b_node) {
+    assert(g != NULL);
+    assert(g->kind == CDS_GRAPH_MATRIX);
+    assert(a_node < (unsigned int) g->nodes);
+    assert(b_node < (unsigned int) g->nodes);
+
+    return _cds_bits_and_count(_CDS_MATRIX_ROW(g, a_node), _CDS_MATRIX_ROW(g, b_node), g->words);
+}
+
+// Popcount instruction is used when CPU has it, otherwise compiler's fallback
+#if defined(__GNUC__) && defined(__x86_64__)
+__attribute__((target("popcnt")))
+static size_t _cds_bits_count_popcnt(const uint64_t *bits, size_t words) {
+    size_t count = 0;
+    for (size_t word=0; word < words; word++) {
+        count += __builtin_popcountll(bits[word]);
+    }
+
+    return count;
+}
+
+__attribute__((target("popcnt")))
+static size_t _cds_bits_and_count_popcnt(const uint64_t *a, const uint64_t *b, size_t words) {
+    size_t count = 0;
+    for (size_t word=0; word < words; word++) {
+        count += __builtin_popcountll(a[word] & b[word]);
+    }
+
+    return count;
+}
+#define _CDS_POPCNT 1
+#endif
+
+size_t _cds_bits_count(const uint64_t *bits, size_t words) {
+#ifdef _CDS_POPCNT
+    if (__builtin_cpu_supports("popcnt")) {
+        return _cds_bits_count_popcnt(bits, words);
+    }
+#endif
+
+    size_t count = 0;
+    for (size_t word=0; word < words; word++) {
+        count += __builtin_popcountll(bits[word]);
+    }
+
+    return count;
+}
+
+size_t _cds_bits_and_count(const uint64_t *a, const uint64_t *b, size_t words) {
+#ifdef _CDS_POPCNT
+    if (__builtin_cpu_supports("popcnt")) {
+        return _cds_bits_and_count_popcnt(a, b, words);
+    }
+#endif
+
+    size_t count = 0;
+    for (size_t word=0; word < words; word++) {
+        count += __builtin_popcountll(a[word] & b[word]);
+    }
+
+    return count;
 }
@@ -0,0 +1,271 @@
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/cds.h>
+
+#include "graph_internal.h"
+#include "pool.h"
+
+// switch to bottom-up once frontier edges exceed unexplored edges / ALPHA
+#define _CDS_BFS_ALPHA 14
+// switch back to top-down once frontier is below nodes / BETA
+#define _CDS_BFS_BETA 24
+// below it a single thread beats waking the pool every level
+#define _CDS_BFS_PARALLEL 4096
+// discovered nodes are published to next frontier in blocks
+#define _CDS_BFS_BLOCK 256
+
+struct _cds_bfs_job {
+    const struct _cds_graph_view* graph;
+    const struct _cds_graph_view* reverse;
+
+    unsigned int* dist;
+    unsigned int* parent;
+    unsigned int level;
+
+    // top-down frontier as a queue
+    const unsigned int* frontier;
+    size_t frontier_size;
+    unsigned int* next;
+    size_t next_size;
+
+    // bottom-up frontier as a bitmap
+    const uint64_t* frontier_bits;
+    uint64_t* next_bits;
+    size_t words;
+
+    // per worker discovered nodes and their out-edges
+    size_t* found;
+    size_t* found_edges;
+};
+
+static void _cds_bfs_top_down(void* context, size_t index, size_t count);
+static void _cds_bfs_bottom_up(void* context, size_t index, size_t count);
+static size_t _cds_bfs_degree(const struct _cds_graph_view* graph, size_t node);
+
+int cds_graph_bfs(cds_graph* g, unsigned int source, unsigned int* out_dist, unsigned int* out_parent, size_t nthreads) {
+    if (g == NULL || source >= (unsigned int) g->nodes) {
+        return CDS_ERR;
+    }
+
+    struct _cds_graph_view graph, reverse = {0};
+    if (_cds_graph_view(g, &graph, false) != CDS_OK) {
+        return CDS_ERR;
+    }
+
+    size_t nodes = graph.nodes;
+    size_t words = (nodes + 63) / 64;
+    size_t threads = nodes < _CDS_BFS_PARALLEL ? 1 : _cds_pool_threads(nthreads);
+
+    unsigned int* parent = out_parent != NULL ? out_parent : malloc(sizeof(unsigned int) * nodes);
+    unsigned int* queues = malloc(sizeof(unsigned int) * nodes * 2);
+    uint64_t* bits = calloc(words * 2 + 1, sizeof(uint64_t));
+    size_t* found = malloc(sizeof(size_t) * threads * 2);
+    _cds_pool pool = _cds_pool_create(threads);
+
+    int status = CDS_ERR;
+    if (parent == NULL || queues == NULL || bits == NULL || found == NULL || pool == NULL) {
+        goto cleanup;
+    }
+
+    for (size_t node = 0; node < nodes; node++) {
+        parent[node] = CDS_GRAPH_UNREACHED;
+    }
+    if (out_dist != NULL) {
+        for (size_t node = 0; node < nodes; node++) {
+            out_dist[node] = CDS_GRAPH_UNREACHED;
+        }
+        out_dist[source] = 0;
+    }
+    parent[source] = source;
+    queues[0] = source;
+
+    struct _cds_bfs_job job = {
+        .graph = &graph,
+        .dist = out_dist,
+        .parent = parent,
+        .frontier = queues,
+        .frontier_size = 1,
+        .next = &queues[nodes],
+        .frontier_bits = bits,
+        .next_bits = &bits[words],
+        .words = words,
+        .found = found,
+        .found_edges = &found[_cds_pool_size(pool)]
+    };
+
+    size_t workers = _cds_pool_size(pool);
+    size_t frontier_edges = _cds_bfs_degree(&graph, source);
+    size_t unexplored_edges = graph.edges - frontier_edges;
+    bool bottom_up = false;
+
+    while (job.frontier_size != 0) {
+        if (!bottom_up && frontier_edges > unexplored_edges / _CDS_BFS_ALPHA) {
+            // reversed edges are only needed once frontier gets large
+            if (job.reverse == NULL) {
+                if (_cds_graph_view_transpose(&graph, &reverse) != CDS_OK) {
+                    goto cleanup;
+                }
+                job.reverse = &reverse;
+            }
+
+            uint64_t* frontier_bits = (uint64_t*) job.frontier_bits;
+            memset(frontier_bits, 0, sizeof(uint64_t) * words);
+            for (size_t i = 0; i < job.frontier_size; i++) {
+                frontier_bits[job.frontier[i] / 64] |= UINT64_C(1) << (job.frontier[i] % 64);
+            }
+            bottom_up = true;
+        } else if (bottom_up && job.frontier_size < nodes / _CDS_BFS_BETA) {
+            unsigned int* frontier = (unsigned int*) job.frontier;
+            size_t size = 0;
+
+            for (size_t word = 0; word < words; word++) {
+                for (uint64_t set = job.frontier_bits[word]; set != 0; set &= set - 1) {
+                    frontier[size++] = (unsigned int) (word * 64 + __builtin_ctzll(set));
+                }
+            }
+            bottom_up = false;
+        }
+
+        job.next_size = 0;
+        _cds_pool_run(pool, bottom_up ? _cds_bfs_bottom_up : _cds_bfs_top_down, &job);
+
+        size_t discovered = 0;
+        frontier_edges = 0;
+        for (size_t worker = 0; worker < workers; worker++) {
+            discovered += job.found[worker];
+            frontier_edges += job.found_edges[worker];
+        }
+        unexplored_edges -= frontier_edges < unexplored_edges ? frontier_edges : unexplored_edges;
+
+        if (bottom_up) {
+            uint64_t* swap = (uint64_t*) job.frontier_bits;
+            job.frontier_bits = job.next_bits;
+            job.next_bits = swap;
+        } else {
+            unsigned int* swap = (unsigned int*) job.frontier;
+            job.frontier = job.next;
+            job.next = swap;
+        }
+
+        job.frontier_size = discovered;
+        job.level++;
+    }
+
+    status = CDS_OK;
+
+cleanup:
+    _cds_pool_destroy(pool);
+    _cds_graph_view_release(&reverse);
+    _cds_graph_view_release(&graph);
+
+    if (parent != out_parent) {
+        free(parent);
+    }
+    free(queues);
+    free(bits);
+    free(found);
+
+    return status;
+}
+
+static void _cds_bfs_top_down(void* context, size_t index, size_t count) {
+    struct _cds_bfs_job* job = context;
+    const struct _cds_graph_view* graph = job->graph;
+
+    size_t begin, end;
+    _cds_pool_split(job->frontier_size, index, count, &begin, &end);
+
+    unsigned int block[_CDS_BFS_BLOCK];
+    size_t used = 0;
+    size_t found = 0, found_edges = 0;
+
+    for (size_t i = begin; i < end; i++) {
+        unsigned int node = job->frontier[i];
+
+        for (size_t e = graph->offsets[node]; e < graph->offsets[node + 1]; e++) {
+            unsigned int neighbor = graph->targets[e];
+            unsigned int unreached = CDS_GRAPH_UNREACHED;
+
+            // plain read filters most visited nodes before paying for CAS
+            if (__atomic_load_n(&job->parent[neighbor], __ATOMIC_RELAXED) != CDS_GRAPH_UNREACHED
+                || !__atomic_compare_exchange_n(&job->parent[neighbor], &unreached, node, false,
+                    __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                continue;
+            }
+
+            if (job->dist != NULL) {
+                job->dist[neighbor] = job->level + 1;
+            }
+            found++;
+            found_edges += _cds_bfs_degree(graph, neighbor);
+
+            block[used++] = neighbor;
+            if (used == _CDS_BFS_BLOCK) {
+                size_t at = __atomic_fetch_add(&job->next_size, used, __ATOMIC_RELAXED);
+                memcpy(&job->next[at], block, sizeof(unsigned int) * used);
+                used = 0;
+            }
+        }
+    }
+
+    if (used != 0) {
+        size_t at = __atomic_fetch_add(&job->next_size, used, __ATOMIC_RELAXED);
+        memcpy(&job->next[at], block, sizeof(unsigned int) * used);
+    }
+
+    job->found[index] = found;
+    job->found_edges[index] = found_edges;
+}
+
+static void _cds_bfs_bottom_up(void* context, size_t index, size_t count) {
+    struct _cds_bfs_job* job = context;
+    const struct _cds_graph_view* reverse = job->reverse;
+
+    // workers own whole words of next bitmap, so no atomics are needed
+    size_t begin, end;
+    _cds_pool_split(job->words, index, count, &begin, &end);
+
+    size_t found = 0, found_edges = 0;
+
+    for (size_t word = begin; word < end; word++) {
+        uint64_t next = 0;
+
+        for (size_t bit = 0; bit < 64; bit++) {
+            size_t node = word * 64 + bit;
+            if (node >= reverse->nodes) {
+                break;
+            }
+            if (job->parent[node] != CDS_GRAPH_UNREACHED) {
+                continue;
+            }
+
+            // first in-neighbor found in frontier becomes parent
+            for (size_t e = reverse->offsets[node]; e < reverse->offsets[node + 1]; e++) {
+                unsigned int neighbor = reverse->targets[e];
+
+                if ((job->frontier_bits[neighbor / 64] >> (neighbor % 64)) & 1) {
+                    job->parent[node] = neighbor;
+                    if (job->dist != NULL) {
+                        job->dist[node] = job->level + 1;
+                    }
+
+                    next |= UINT64_C(1) << bit;
+                    found++;
+                    found_edges += _cds_bfs_degree(job->graph, node);
+                    break;
+                }
+            }
+        }
+
+        job->next_bits[word] = next;
+    }
+
+    job->found[index] = found;
+    job->found_edges[index] = found_edges;
+}
+
+static size_t _cds_bfs_degree(const struct _cds_graph_view* graph, size_t node) {
+    return graph->offsets[node + 1] - graph->offsets[node];
+}
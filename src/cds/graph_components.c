@@ -0,0 +1,89 @@
+#include <stdlib.h>
+
+#include <cds/dsu.h>
+
+#include "graph_internal.h"
+#include "pool.h"
+
+// below it unions run in caller's thread
+#define _CDS_COMPONENTS_PARALLEL 16384
+
+struct _cds_components_job {
+    const struct _cds_graph_view* graph;
+    cds_dsu dsu;
+};
+
+static void _cds_components_union(void* context, size_t index, size_t count);
+
+int cds_graph_components(cds_graph* g, unsigned int* labels_out, size_t nthreads) {
+    if (g == NULL || labels_out == NULL) {
+        return CDS_ERR;
+    }
+
+    struct _cds_graph_view graph;
+    if (_cds_graph_view(g, &graph, false) != CDS_OK) {
+        return CDS_ERR;
+    }
+
+    size_t threads = graph.edges < _CDS_COMPONENTS_PARALLEL ? 1 : _cds_pool_threads(nthreads);
+    cds_dsu dsu = cds_dsu_create(graph.nodes, cds_memory_system());
+    _cds_pool pool = threads > 1 ? _cds_pool_create(threads) : NULL;
+
+    if (dsu == NULL || (threads > 1 && pool == NULL)) {
+        cds_dsu_destroy(dsu);
+        _cds_graph_view_release(&graph);
+        return CDS_ERR;
+    }
+
+    if (pool == NULL) {
+        for (size_t node = 0; node < graph.nodes; node++) {
+            for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                cds_dsu_union(dsu, node, graph.targets[e]);
+            }
+        }
+    } else {
+        // workers union edges of disjoint row ranges at once
+        struct _cds_components_job job = {.graph = &graph, .dsu = dsu};
+        _cds_pool_run(pool, _cds_components_union, &job);
+    }
+
+    // labels are dense, components numbered in order of their lowest node
+    for (size_t node = 0; node < graph.nodes; node++) {
+        labels_out[node] = CDS_GRAPH_UNREACHED;
+    }
+
+    unsigned int next = 0;
+    for (size_t node = 0; node < graph.nodes; node++) {
+        size_t root = cds_dsu_find(dsu, node);
+
+        if (labels_out[root] == CDS_GRAPH_UNREACHED) {
+            labels_out[root] = next++;
+        }
+        labels_out[node] = labels_out[root];
+    }
+
+    _cds_pool_destroy(pool);
+    cds_dsu_destroy(dsu);
+    _cds_graph_view_release(&graph);
+
+    return CDS_OK;
+}
+
+static void _cds_components_union(void* context, size_t index, size_t count) {
+    struct _cds_components_job* job = context;
+    const struct _cds_graph_view* graph = job->graph;
+
+    // rows are split by edge count, so workers get similar work
+    size_t begin, end;
+    _cds_pool_split(graph->edges, index, count, &begin, &end);
+
+    size_t node = _cds_graph_view_row(graph, begin);
+
+    for (size_t e = begin; e < end; e++) {
+        while (graph->offsets[node + 1] <= e) {
+            node++;
+        }
+
+        cds_dsu_union_concurrent(job->dsu, node, graph->targets[e]);
+    }
+}
@@ -0,0 +1,179 @@
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph_internal.h"
+
+static int _cds_target_cmp(const void* a, const void* b);
+static size_t _cds_row_search(cds_graph* g, unsigned int from_node, unsigned int to_node);
+
+cds_graph* cds_create_csr_graph(int nodes, const struct cds_edge* edges, size_t count) {
+    if (nodes < 0 || (edges == NULL && count != 0)) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (edges[i].from >= (unsigned int) nodes || edges[i].to >= (unsigned int) nodes) {
+            return NULL;
+        }
+    }
+
+    cds_graph* g = calloc(1, sizeof(cds_graph));
+    if (g == NULL) {
+        return NULL;
+    }
+
+    g->nodes = nodes;
+    g->kind = CDS_GRAPH_CSR;
+    g->offsets = calloc((size_t) nodes + 1, sizeof(size_t));
+    g->targets = malloc(sizeof(unsigned int) * (count != 0 ? count : 1));
+    g->capacity = count;
+
+    if (g->offsets == NULL || g->targets == NULL) {
+        _cds_csr_destroy(g);
+        return NULL;
+    }
+
+    // count out-degrees and turn them into row offsets
+    for (size_t i = 0; i < count; i++) {
+        g->offsets[edges[i].from + 1]++;
+    }
+    for (int node = 0; node < nodes; node++) {
+        g->offsets[node + 1] += g->offsets[node];
+    }
+
+    // scatter targets by source, offsets[from] is used as a cursor
+    for (size_t i = 0; i < count; i++) {
+        g->targets[g->offsets[edges[i].from]++] = edges[i].to;
+    }
+    for (int node = nodes; node > 0; node--) {
+        g->offsets[node] = g->offsets[node - 1];
+    }
+    g->offsets[0] = 0;
+
+    // sort every row and drop repeated edges, rows are compacted in place
+    size_t written = 0;
+    for (int node = 0; node < nodes; node++) {
+        size_t begin = g->offsets[node];
+        size_t end = g->offsets[node + 1];
+        unsigned int* row = &g->targets[begin];
+
+        qsort(row, end - begin, sizeof(unsigned int), _cds_target_cmp);
+
+        g->offsets[node] = written;
+        for (size_t i = 0; i < end - begin; i++) {
+            if (i == 0 || row[i] != row[i - 1]) {
+                g->targets[written++] = row[i];
+            }
+        }
+    }
+    g->offsets[nodes] = written;
+
+    return g;
+}
+
+void _cds_csr_destroy(cds_graph* g) {
+    if (g->mapping != NULL) {
+        _cds_snapshot_release(g);
+        return;
+    }
+
+    free(g->offsets);
+    free(g->targets);
+    free(g);
+}
+
+bool _cds_csr_add_edge(cds_graph* g, unsigned int from_node, unsigned int to_node) {
+    size_t pos = _cds_row_search(g, from_node, to_node);
+    size_t edges = g->offsets[g->nodes];
+
+    if (g->mapping != NULL || (pos < g->offsets[from_node + 1] && g->targets[pos] == to_node)) {
+        return false;
+    }
+
+    if (edges == g->capacity) {
+        size_t capacity = g->capacity != 0 ? g->capacity * 2 : 8;
+        unsigned int* targets = realloc(g->targets, sizeof(unsigned int) * capacity);
+
+        if (targets == NULL) {
+            return false;
+        }
+
+        g->targets = targets;
+        g->capacity = capacity;
+    }
+
+    // every later row moves one slot, bulk building is the fast way
+    memmove(&g->targets[pos + 1], &g->targets[pos], sizeof(unsigned int) * (edges - pos));
+    g->targets[pos] = to_node;
+
+    for (int node = from_node + 1; node <= g->nodes; node++) {
+        g->offsets[node]++;
+    }
+
+    return true;
+}
+
+bool _cds_csr_has_edge(cds_graph* g, unsigned int from_node, unsigned int to_node) {
+    size_t pos = _cds_row_search(g, from_node, to_node);
+    return pos < g->offsets[from_node + 1] && g->targets[pos] == to_node;
+}
+
+bool _cds_csr_remove_edge(cds_graph* g, unsigned int from_node, unsigned int to_node) {
+    size_t pos = _cds_row_search(g, from_node, to_node);
+    size_t edges = g->offsets[g->nodes];
+
+    if (g->mapping != NULL || pos == g->offsets[from_node + 1] || g->targets[pos] != to_node) {
+        return false;
+    }
+
+    memmove(&g->targets[pos], &g->targets[pos + 1], sizeof(unsigned int) * (edges - pos - 1));
+
+    for (int node = from_node + 1; node <= g->nodes; node++) {
+        g->offsets[node]--;
+    }
+
+    return true;
+}
+
+int _cds_csr_add_node(cds_graph* g) {
+    if (g->nodes == INT_MAX || g->mapping != NULL) {
+        return -1;
+    }
+
+    size_t* offsets = realloc(g->offsets, sizeof(size_t) * ((size_t) g->nodes + 2));
+    if (offsets == NULL) {
+        return -1;
+    }
+
+    // new node has an empty row at the end
+    offsets[g->nodes + 1] = offsets[g->nodes];
+    g->offsets = offsets;
+
+    return g->nodes++;
+}
+
+static int _cds_target_cmp(const void* a, const void* b) {
+    unsigned int x = *(const unsigned int*) a;
+    unsigned int y = *(const unsigned int*) b;
+
+    return (x > y) - (x < y);
+}
+
+// first position in row not lower than to_node
+static size_t _cds_row_search(cds_graph* g, unsigned int from_node, unsigned int to_node) {
+    size_t low = g->offsets[from_node];
+    size_t high = g->offsets[from_node + 1];
+
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+
+        if (g->targets[middle] < to_node) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
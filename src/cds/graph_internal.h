@@ -0,0 +1,104 @@
+#ifndef CDS_GRAPH_INTERNAL_GUARD_HEADER
+#define CDS_GRAPH_INTERNAL_GUARD_HEADER
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cds/graph.h>
+#include <cds/iter.h>
+#include <cds/vector.h>
+
+/*
+ * Graph layout shared between backends, not part of the public API.
+ *
+ * Every backend keeps node count in nodes, public functions dispatch on kind.
+ */
+
+struct cds_graph {
+    int nodes;
+    enum cds_graph_kind kind;
+
+    // CDS_GRAPH_MATRIX, a bit per edge, row i starts at bits[i * words]
+    uint64_t* bits;
+    size_t words;
+
+    // CDS_GRAPH_CSR, neighbors of node i are targets[offsets[i]..offsets[i + 1])
+    size_t* offsets;
+    unsigned int* targets;
+    size_t capacity;
+    // snapshot mapped read-only, offsets and targets point into it
+    void* mapping;
+    size_t mapped;
+
+    // CDS_GRAPH_LIST, a struct _cds_list_row per node
+    cds_vector rows;
+};
+
+// neighbors of a list graph node, vectors are created with first edge
+struct _cds_list_row {
+    cds_vector targets;
+    // NULL while every edge of row weighs 1
+    cds_vector weights;
+};
+
+// rows of the matrix are padded to whole cache lines
+#define _CDS_MATRIX_ALIGN 64
+#define _CDS_MATRIX_LINE (_CDS_MATRIX_ALIGN / sizeof(uint64_t))
+#define _CDS_MATRIX_WORDS(nodes) (((size_t) (nodes) + 64 * _CDS_MATRIX_LINE - 1) / (64 * _CDS_MATRIX_LINE) * _CDS_MATRIX_LINE)
+#define _CDS_MATRIX_ROW(g, node) (&(g)->bits[(size_t) (node) * (g)->words])
+
+// count set bits, using popcount instruction when CPU has it
+size_t _cds_bits_count(const uint64_t* bits, size_t words);
+size_t _cds_bits_and_count(const uint64_t* a, const uint64_t* b, size_t words);
+
+/*
+ * Read-only CSR view of any graph, algorithms work on it so they don't care
+ * about backend. CSR graphs are viewed in place, others are converted.
+ */
+struct _cds_graph_view {
+    size_t nodes;
+    size_t edges;
+    const size_t* offsets;
+    const unsigned int* targets;
+    // weight of every target, NULL when all edges weigh 1
+    const double* weights;
+    // every row is in ascending order
+    bool sorted;
+
+    // rows of list graphs are not sorted, arrays built for this view are
+    // released with it
+    size_t* owned_offsets;
+    unsigned int* owned_targets;
+    double* owned_weights;
+};
+
+// weights are only copied when asked for, transposed views have none
+int _cds_graph_view(cds_graph* g, struct _cds_graph_view* view, bool weights);
+int _cds_graph_view_transpose(const struct _cds_graph_view* view, struct _cds_graph_view* out);
+// sorts rows of list views with their weights, others are already sorted
+int _cds_graph_view_sort(struct _cds_graph_view* view);
+// row holding given edge, binary search over offsets; nodes for edge count
+size_t _cds_graph_view_row(const struct _cds_graph_view* view, size_t edge);
+void _cds_graph_view_release(struct _cds_graph_view* view);
+
+// CSR backend, see graph_csr.c
+void _cds_csr_destroy(cds_graph* g);
+bool _cds_csr_add_edge(cds_graph* g, unsigned int from_node, unsigned int to_node);
+bool _cds_csr_has_edge(cds_graph* g, unsigned int from_node, unsigned int to_node);
+bool _cds_csr_remove_edge(cds_graph* g, unsigned int from_node, unsigned int to_node);
+int _cds_csr_add_node(cds_graph* g);
+
+// mapped CSR snapshots, see graph_snapshot.c
+void _cds_snapshot_release(cds_graph* g);
+
+// list backend, see graph_list.c
+void _cds_list_destroy(cds_graph* g);
+// repeats are only looked for when checked
+bool _cds_list_add_edge(cds_graph* g, unsigned int from_node, unsigned int to_node, double weight, bool checked);
+bool _cds_list_has_edge(cds_graph* g, unsigned int from_node, unsigned int to_node);
+bool _cds_list_remove_edge(cds_graph* g, unsigned int from_node, unsigned int to_node);
+bool _cds_list_weight(cds_graph* g, unsigned int from_node, unsigned int to_node, double* out);
+int _cds_list_add_node(cds_graph* g);
+size_t _cds_list_out_degree(cds_graph* g, unsigned int node);
+
+#endif // CDS_GRAPH_INTERNAL_GUARD_HEADER
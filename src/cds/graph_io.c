@@ -0,0 +1,444 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <cds/vector.h>
+
+#include "graph_internal.h"
+
+// output is rendered here and written in one call when full
+#define _CDS_IO_BUFFER ((size_t) 1 << 20)
+// longest text line a writer emits, two ids and separators
+#define _CDS_IO_LINE 64
+#define _CDS_IO_VERSION 1
+
+// header of binary edge lists, in native byte order, edges follow as
+// pairs of uint32_t
+struct _cds_edgelist_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t unused;
+    uint64_t nodes;
+    uint64_t edges;
+};
+
+struct _cds_sink {
+    uint8_t* buffer;
+    size_t used;
+
+    // exactly one of them is used
+    int fd;
+    FILE* file;
+
+    bool failed;
+};
+
+struct _cds_source {
+    uint8_t* buffer;
+    size_t used;
+    size_t read;
+    int fd;
+    bool eof;
+};
+
+static int _cds_graph_write(cds_graph* g, struct _cds_sink* sink, enum cds_graph_format format);
+static void _cds_sink_flush(struct _cds_sink* sink);
+static void _cds_sink_bytes(struct _cds_sink* sink, const void* bytes, size_t count);
+static void _cds_sink_text(struct _cds_sink* sink, const char* text);
+static void _cds_sink_edge(struct _cds_sink* sink, enum cds_graph_format format, unsigned int from, unsigned int to);
+static size_t _cds_format_uint(char* out, uint64_t value);
+static bool _cds_source_fill(struct _cds_source* source);
+static cds_graph* _cds_read_text(struct _cds_source* source, cds_vector edges);
+static cds_graph* _cds_read_binary(struct _cds_source* source, cds_vector edges);
+static bool _cds_parse_uint(const uint8_t** at, const uint8_t* end, uint64_t* out);
+
+int cds_graph_write_fd(cds_graph* g, int fd, enum cds_graph_format format) {
+    if (g == NULL || fd < 0) {
+        return CDS_ERR;
+    }
+
+    struct _cds_sink sink = {.buffer = malloc(_CDS_IO_BUFFER), .fd = fd};
+    int status = _cds_graph_write(g, &sink, format);
+
+    free(sink.buffer);
+    return status;
+}
+
+int cds_graph_write_file(cds_graph* g, FILE* file, enum cds_graph_format format) {
+    if (g == NULL || file == NULL) {
+        return CDS_ERR;
+    }
+
+    struct _cds_sink sink = {.buffer = malloc(_CDS_IO_BUFFER), .fd = -1, .file = file};
+    int status = _cds_graph_write(g, &sink, format);
+
+    free(sink.buffer);
+    return status;
+}
+
+int cds_graph_save_edgelist(cds_graph* g, const char* path, enum cds_graph_format format) {
+    if (g == NULL || path == NULL) {
+        return CDS_ERR;
+    }
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return CDS_ERR;
+    }
+
+    int status = cds_graph_write_fd(g, fd, format);
+    if (close(fd) != 0) {
+        status = CDS_ERR;
+    }
+
+    return status;
+}
+
+cds_graph* cds_graph_read_fd(int fd, enum cds_graph_format format) {
+    if (fd < 0 || (format != CDS_GRAPH_FORMAT_TEXT && format != CDS_GRAPH_FORMAT_BINARY)) {
+        return NULL;
+    }
+
+    struct _cds_source source = {.buffer = malloc(_CDS_IO_BUFFER), .fd = fd};
+    cds_vector edges = cds_vector_create((struct cds_vector_config) {
+        .type = sizeof(struct cds_edge),
+        .memory = cds_memory_system()
+    });
+
+    cds_graph* g = NULL;
+    if (source.buffer != NULL && edges != NULL) {
+        g = format == CDS_GRAPH_FORMAT_TEXT ? _cds_read_text(&source, edges) : _cds_read_binary(&source, edges);
+    }
+
+    cds_vector_destroy(edges);
+    free(source.buffer);
+
+    return g;
+}
+
+cds_graph* cds_graph_load_edgelist(const char* path, enum cds_graph_format format) {
+    if (path == NULL) {
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    cds_graph* g = cds_graph_read_fd(fd, format);
+    close(fd);
+
+    return g;
+}
+
+static int _cds_graph_write(cds_graph* g, struct _cds_sink* sink, enum cds_graph_format format) {
+    if (sink->buffer == NULL) {
+        return CDS_ERR;
+    }
+
+    size_t edges = 0;
+    for (int node = 0; node < g->nodes; node++) {
+        edges += cds_graph_out_degree(g, (unsigned int) node);
+    }
+
+    char line[_CDS_IO_LINE];
+    switch (format) {
+        case CDS_GRAPH_FORMAT_TEXT:
+            _cds_sink_text(sink, "# nodes ");
+            line[_cds_format_uint(line, (uint64_t) g->nodes)] = '\0';
+            _cds_sink_text(sink, line);
+            _cds_sink_text(sink, " edges ");
+            line[_cds_format_uint(line, edges)] = '\0';
+            _cds_sink_text(sink, line);
+            _cds_sink_text(sink, "\n");
+            break;
+        case CDS_GRAPH_FORMAT_BINARY: {
+            struct _cds_edgelist_header header = {
+                .magic = "CDSEDGE",
+                .version = _CDS_IO_VERSION,
+                .nodes = (uint64_t) g->nodes,
+                .edges = edges
+            };
+            _cds_sink_bytes(sink, &header, sizeof(header));
+            break;
+        }
+        case CDS_GRAPH_FORMAT_DOT:
+            _cds_sink_text(sink, "digraph {\n");
+            break;
+        default:
+            return CDS_ERR;
+    }
+
+    struct cds_iter_i iter;
+    for (int node = 0; node < g->nodes; node++) {
+        unsigned int from = (unsigned int) node;
+        cds_graph_neighbors_init(&iter, g, from);
+
+        CDS_ITER_EACH(&iter, const unsigned int*, to, {
+            _cds_sink_edge(sink, format, from, *to);
+        });
+    }
+
+    if (format == CDS_GRAPH_FORMAT_DOT) {
+        _cds_sink_text(sink, "}\n");
+    }
+
+    _cds_sink_flush(sink);
+    if (sink->file != NULL && fflush(sink->file) != 0) {
+        sink->failed = true;
+    }
+
+    return sink->failed ? CDS_ERR : CDS_OK;
+}
+
+static void _cds_sink_flush(struct _cds_sink* sink) {
+    if (sink->failed || sink->used == 0) {
+        sink->used = 0;
+        return;
+    }
+
+    if (sink->file != NULL) {
+        sink->failed = fwrite(sink->buffer, 1, sink->used, sink->file) != sink->used;
+    } else {
+        // write may take less than asked, loop until everything is out
+        for (size_t written = 0; written < sink->used && !sink->failed;) {
+            ssize_t result = write(sink->fd, &sink->buffer[written], sink->used - written);
+
+            sink->failed = result <= 0;
+            written += result > 0 ? (size_t) result : 0;
+        }
+    }
+
+    sink->used = 0;
+}
+
+static void _cds_sink_bytes(struct _cds_sink* sink, const void* bytes, size_t count) {
+    if (_CDS_IO_BUFFER - sink->used < count) {
+        _cds_sink_flush(sink);
+    }
+
+    memcpy(&sink->buffer[sink->used], bytes, count);
+    sink->used += count;
+}
+
+static void _cds_sink_text(struct _cds_sink* sink, const char* text) {
+    _cds_sink_bytes(sink, text, strlen(text));
+}
+
+static void _cds_sink_edge(struct _cds_sink* sink, enum cds_graph_format format, unsigned int from, unsigned int to) {
+    if (_CDS_IO_BUFFER - sink->used < _CDS_IO_LINE) {
+        _cds_sink_flush(sink);
+    }
+
+    if (format == CDS_GRAPH_FORMAT_BINARY) {
+        uint32_t pair[2] = {from, to};
+        _cds_sink_bytes(sink, pair, sizeof(pair));
+        return;
+    }
+
+    const char* separator = format == CDS_GRAPH_FORMAT_DOT ? " -> " : " ";
+    const char* ending = format == CDS_GRAPH_FORMAT_DOT ? ";\n" : "\n";
+
+    // ids are rendered straight into buffer, no printf per edge
+    char* out = (char*) &sink->buffer[sink->used];
+    size_t length = _cds_format_uint(out, from);
+
+    for (const char* c = separator; *c != '\0'; c++) {
+        out[length++] = *c;
+    }
+    length += _cds_format_uint(&out[length], to);
+    for (const char* c = ending; *c != '\0'; c++) {
+        out[length++] = *c;
+    }
+
+    sink->used += length;
+}
+
+static size_t _cds_format_uint(char* out, uint64_t value) {
+    char digits[20];
+    size_t count = 0;
+
+    do {
+        digits[count++] = (char) ('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    for (size_t i = 0; i < count; i++) {
+        out[i] = digits[count - 1 - i];
+    }
+
+    return count;
+}
+
+// move unread bytes to front and read more after them
+static bool _cds_source_fill(struct _cds_source* source) {
+    if (source->eof) {
+        return false;
+    }
+
+    memmove(source->buffer, &source->buffer[source->read], source->used - source->read);
+    source->used -= source->read;
+    source->read = 0;
+
+    while (source->used < _CDS_IO_BUFFER) {
+        ssize_t result = read(source->fd, &source->buffer[source->used], _CDS_IO_BUFFER - source->used);
+
+        if (result <= 0) {
+            source->eof = true;
+            break;
+        }
+        source->used += (size_t) result;
+    }
+
+    return true;
+}
+
+static cds_graph* _cds_read_text(struct _cds_source* source, cds_vector edges) {
+    uint64_t nodes = 0;
+    bool sized = false;
+
+    while (true) {
+        _cds_source_fill(source);
+
+        const uint8_t* at = &source->buffer[source->read];
+        const uint8_t* end = &source->buffer[source->used];
+
+        // only whole lines are parsed, last one may continue in next chunk
+        const uint8_t* last = end;
+        if (!source->eof) {
+            while (last > at && last[-1] != '\n') {
+                last--;
+            }
+            if (last == at) {
+                // a line longer than buffer
+                return NULL;
+            }
+        }
+
+        while (at < last) {
+            const uint8_t* line_end = memchr(at, '\n', (size_t) (last - at));
+            if (line_end == NULL) {
+                line_end = last;
+            }
+
+            uint64_t from, to;
+            const uint8_t* cursor = at;
+
+            if (*at == '#' || *at == '%') {
+                // comments, "# nodes N" gives node count
+                static const char prefix[] = "# nodes ";
+                cursor += sizeof(prefix) - 1;
+
+                if (!sized && line_end - at > (ptrdiff_t) sizeof(prefix) - 1
+                    && memcmp(at, prefix, sizeof(prefix) - 1) == 0 && _cds_parse_uint(&cursor, line_end, &nodes)) {
+                    sized = true;
+                }
+            } else if (_cds_parse_uint(&cursor, line_end, &from)) {
+                if (!_cds_parse_uint(&cursor, line_end, &to) || from > UINT32_MAX || to > UINT32_MAX) {
+                    return NULL;
+                }
+
+                struct cds_edge* edge = cds_vector_emplace_back(edges);
+                if (edge == NULL) {
+                    return NULL;
+                }
+                *edge = (struct cds_edge) {.from = (unsigned int) from, .to = (unsigned int) to};
+
+                if (!sized && from >= nodes) {
+                    nodes = from + 1;
+                }
+                if (!sized && to >= nodes) {
+                    nodes = to + 1;
+                }
+            }
+
+            at = line_end + 1;
+        }
+
+        source->read = source->used - (size_t) (end - last);
+        if (source->eof) {
+            break;
+        }
+    }
+
+    if (nodes > INT_MAX) {
+        return NULL;
+    }
+
+    return cds_create_csr_graph((int) nodes, cds_vector_data(edges), cds_vector_size(edges));
+}
+
+static cds_graph* _cds_read_binary(struct _cds_source* source, cds_vector edges) {
+    struct _cds_edgelist_header header;
+
+    _cds_source_fill(source);
+    if (source->used < sizeof(header)) {
+        return NULL;
+    }
+
+    memcpy(&header, source->buffer, sizeof(header));
+    source->read = sizeof(header);
+
+    if (memcmp(header.magic, "CDSEDGE", sizeof("CDSEDGE")) != 0 || header.version != _CDS_IO_VERSION
+        || header.nodes > INT_MAX || header.edges > SIZE_MAX / sizeof(struct cds_edge)) {
+        return NULL;
+    }
+
+    // edge count is known, so edges are read straight into their final place
+    if (cds_vector_resize(edges, (size_t) header.edges, NULL) != CDS_OK) {
+        return NULL;
+    }
+
+    struct cds_edge* out = cds_vector_data(edges);
+    size_t pending = (size_t) header.edges;
+    uint32_t pair[2];
+
+    while (pending != 0) {
+        size_t available = (source->used - source->read) / sizeof(pair);
+        if (available == 0) {
+            if (!_cds_source_fill(source) || source->used - source->read < sizeof(pair)) {
+                return NULL;
+            }
+            continue;
+        }
+
+        size_t count = available < pending ? available : pending;
+        for (size_t i = 0; i < count; i++) {
+            memcpy(pair, &source->buffer[source->read + i * sizeof(pair)], sizeof(pair));
+            *out++ = (struct cds_edge) {.from = pair[0], .to = pair[1]};
+        }
+
+        source->read += count * sizeof(pair);
+        pending -= count;
+    }
+
+    return cds_create_csr_graph((int) header.nodes, cds_vector_data(edges), cds_vector_size(edges));
+}
+
+static bool _cds_parse_uint(const uint8_t** at, const uint8_t* end, uint64_t* out) {
+    const uint8_t* cursor = *at;
+
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == ',' || *cursor == '\r')) {
+        cursor++;
+    }
+
+    if (cursor == end || *cursor < '0' || *cursor > '9') {
+        return false;
+    }
+
+    uint64_t value = 0;
+    while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+        if (value > (UINT64_MAX - 9) / 10) {
+            return false;
+        }
+        value = value * 10 + (uint64_t) (*cursor++ - '0');
+    }
+
+    *at = cursor;
+    *out = value;
+
+    return true;
+}
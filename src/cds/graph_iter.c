@@ -0,0 +1,165 @@
+#include <assert.h>
+
+#include "graph_internal.h"
+
+// matrix row scan, bits holds what is left of current word
+struct _cds_matrix_iterdata {
+    const uint64_t* row;
+    size_t word;
+    uint64_t bits;
+    unsigned int current;
+};
+
+// CSR and list rows are already arrays of neighbors
+struct _cds_row_iterdata {
+    const unsigned int* at;
+    const unsigned int* end;
+};
+
+static_assert(sizeof(struct _cds_matrix_iterdata) <= CDS_ITER_STATE, "matrix iterator state does not fit");
+static_assert(sizeof(struct _cds_row_iterdata) <= CDS_ITER_STATE, "row iterator state does not fit");
+
+static void* _cds_graph_iter_state(CDS_ITER(T) iter, cds_graph* g, unsigned int node);
+static bool _cds_matrix_hasnext(void* structure, void** data);
+static void* _cds_matrix_next(void* structure, void** data);
+static bool _cds_row_hasnext(void* structure, void** data);
+static void* _cds_row_next(void* structure, void** data);
+static size_t _cds_row_next_batch(void* structure, void** data, void** out, size_t max);
+static bool _cds_graph_iter_valid(void* structure, void* data);
+
+static const struct cds_iter_vtable _cds_matrix_iter = {
+    .has_next = _cds_matrix_hasnext,
+    .next = _cds_matrix_next,
+    .is_valid = _cds_graph_iter_valid
+};
+
+static const struct cds_iter_vtable _cds_row_iter = {
+    .has_next = _cds_row_hasnext,
+    .next = _cds_row_next,
+    .next_batch = _cds_row_next_batch,
+    .is_valid = _cds_graph_iter_valid
+};
+
+CDS_ITER(unsigned int) cds_graph_neighbors(cds_graph* g, unsigned int node) {
+    if (g == NULL || node >= (unsigned int) g->nodes) {
+        return NULL;
+    }
+
+    struct cds_iter_config config = {
+        .memory = cds_memory_system(),
+        .vtable = g->kind == CDS_GRAPH_MATRIX ? &_cds_matrix_iter : &_cds_row_iter
+    };
+
+    CDS_ITER(unsigned int) iter = cds_iter_create(g, config);
+
+    if (iter != NULL) {
+        iter->data = _cds_graph_iter_state(iter, g, node);
+    }
+
+    return iter;
+}
+
+void cds_graph_neighbors_init(CDS_ITER(unsigned int) iter, cds_graph* g, unsigned int node) {
+    if (iter == NULL || g == NULL || node >= (unsigned int) g->nodes) {
+        return;
+    }
+
+    const struct cds_iter_vtable* vtable = g->kind == CDS_GRAPH_MATRIX ? &_cds_matrix_iter : &_cds_row_iter;
+    cds_iter_init(iter, g, vtable, _cds_graph_iter_state(iter, g, node));
+}
+
+static void* _cds_graph_iter_state(CDS_ITER(T) iter, cds_graph* g, unsigned int node) {
+    // iterator data lives inside the iterator, no allocation needed
+    if (g->kind == CDS_GRAPH_MATRIX) {
+        struct _cds_matrix_iterdata* iterdata = (struct _cds_matrix_iterdata*) iter->state;
+
+        iterdata->row = _CDS_MATRIX_ROW(g, node);
+        iterdata->word = 0;
+        iterdata->bits = g->words != 0 ? iterdata->row[0] : 0;
+
+        return iterdata;
+    }
+
+    struct _cds_row_iterdata* iterdata = (struct _cds_row_iterdata*) iter->state;
+
+    if (g->kind == CDS_GRAPH_CSR) {
+        iterdata->at = &g->targets[g->offsets[node]];
+        iterdata->end = &g->targets[g->offsets[node + 1]];
+    } else {
+        cds_vector targets = ((struct _cds_list_row*) cds_vector_data(g->rows))[node].targets;
+
+        iterdata->at = cds_vector_data(targets);
+        iterdata->end = iterdata->at + cds_vector_size(targets);
+    }
+
+    return iterdata;
+}
+
+static bool _cds_matrix_hasnext(void* structure, void** data) {
+    if (structure == NULL || data == NULL || *data == NULL) {
+        return false;
+    }
+
+    cds_graph* g = structure;
+    struct _cds_matrix_iterdata* iterdata = *data;
+
+    // empty words are skipped, position is kept for next call
+    while (iterdata->bits == 0) {
+        if (iterdata->word + 1 >= g->words) {
+            return false;
+        }
+        iterdata->bits = iterdata->row[++iterdata->word];
+    }
+
+    return true;
+}
+
+static void* _cds_matrix_next(void* structure, void** data) {
+    if (!_cds_matrix_hasnext(structure, data)) {
+        return NULL;
+    }
+
+    struct _cds_matrix_iterdata* iterdata = *data;
+
+    iterdata->current = (unsigned int) (iterdata->word * 64 + __builtin_ctzll(iterdata->bits));
+    iterdata->bits &= iterdata->bits - 1;
+
+    return &iterdata->current;
+}
+
+static bool _cds_row_hasnext(void* structure, void** data) {
+    if (structure == NULL || data == NULL || *data == NULL) {
+        return false;
+    }
+
+    struct _cds_row_iterdata* iterdata = *data;
+    return iterdata->at < iterdata->end;
+}
+
+static void* _cds_row_next(void* structure, void** data) {
+    if (!_cds_row_hasnext(structure, data)) {
+        return NULL;
+    }
+
+    struct _cds_row_iterdata* iterdata = *data;
+    return (void*) iterdata->at++;
+}
+
+static size_t _cds_row_next_batch(void* structure, void** data, void** out, size_t max) {
+    if (!_cds_row_hasnext(structure, data)) {
+        return 0;
+    }
+
+    struct _cds_row_iterdata* iterdata = *data;
+    size_t count = (size_t) (iterdata->end - iterdata->at);
+    count = count < max ? count : max;
+
+    *out = (void*) iterdata->at;
+    iterdata->at += count;
+
+    return count;
+}
+
+static bool _cds_graph_iter_valid(void* structure, void* data) {
+    return structure != NULL && data != NULL;
+}
@@ -0,0 +1,174 @@
+#include <limits.h>
+#include <stdlib.h>
+
+#include <cds/vector.h>
+
+#include "graph_internal.h"
+
+static struct _cds_list_row* _cds_list_rows(cds_graph* g);
+static size_t _cds_list_find(struct _cds_list_row* row, unsigned int to_node);
+static int _cds_list_weigh(struct _cds_list_row* row);
+
+cds_graph* cds_create_list_graph(int nodes) {
+    if (nodes < 0) {
+        return NULL;
+    }
+
+    cds_graph* g = calloc(1, sizeof(cds_graph));
+    if (g == NULL) {
+        return NULL;
+    }
+
+    g->kind = CDS_GRAPH_LIST;
+    g->rows = cds_vector_create((struct cds_vector_config) {
+        .type = sizeof(struct _cds_list_row),
+        .capacity = (size_t) nodes,
+        .memory = cds_memory_system()
+    });
+
+    // every row starts empty, its vectors are created with first edge
+    if (g->rows == NULL || cds_vector_resize(g->rows, (size_t) nodes, NULL) != CDS_OK) {
+        _cds_list_destroy(g);
+        return NULL;
+    }
+
+    g->nodes = nodes;
+    return g;
+}
+
+void _cds_list_destroy(cds_graph* g) {
+    struct _cds_list_row* rows = _cds_list_rows(g);
+
+    for (int node = 0; node < g->nodes; node++) {
+        cds_vector_destroy(rows[node].targets);
+        cds_vector_destroy(rows[node].weights);
+    }
+
+    cds_vector_destroy(g->rows);
+    free(g);
+}
+
+bool _cds_list_add_edge(cds_graph* g, unsigned int from_node, unsigned int to_node, double weight, bool checked) {
+    struct _cds_list_row* row = &_cds_list_rows(g)[from_node];
+
+    if (row->targets == NULL) {
+        row->targets = cds_vector_create((struct cds_vector_config) {
+            .type = sizeof(unsigned int),
+            .memory = cds_memory_system()
+        });
+
+        if (row->targets == NULL) {
+            return false;
+        }
+    }
+
+    if (checked && _cds_list_find(row, to_node) != CDS_VECTOR_NPOS) {
+        return false;
+    }
+
+    // weights are only stored once a row has an edge not weighing 1
+    if (weight != 1 && row->weights == NULL && _cds_list_weigh(row) != CDS_OK) {
+        return false;
+    }
+
+    if (cds_vector_pushback(row->targets, &to_node) != CDS_OK) {
+        return false;
+    }
+
+    if (row->weights != NULL && cds_vector_pushback(row->weights, &weight) != CDS_OK) {
+        cds_vector_popback(row->targets, NULL);
+        return false;
+    }
+
+    return true;
+}
+
+bool _cds_list_has_edge(cds_graph* g, unsigned int from_node, unsigned int to_node) {
+    return _cds_list_find(&_cds_list_rows(g)[from_node], to_node) != CDS_VECTOR_NPOS;
+}
+
+bool _cds_list_remove_edge(cds_graph* g, unsigned int from_node, unsigned int to_node) {
+    struct _cds_list_row* row = &_cds_list_rows(g)[from_node];
+    size_t pos = _cds_list_find(row, to_node);
+
+    if (pos == CDS_VECTOR_NPOS) {
+        return false;
+    }
+
+    // last edge takes removed one's place, rows are not ordered
+    unsigned int* targets = cds_vector_data(row->targets);
+    size_t last = cds_vector_size(row->targets) - 1;
+
+    targets[pos] = targets[last];
+    cds_vector_popback(row->targets, NULL);
+
+    if (row->weights != NULL) {
+        double* weights = cds_vector_data(row->weights);
+
+        weights[pos] = weights[last];
+        cds_vector_popback(row->weights, NULL);
+    }
+
+    return true;
+}
+
+bool _cds_list_weight(cds_graph* g, unsigned int from_node, unsigned int to_node, double* out) {
+    struct _cds_list_row* row = &_cds_list_rows(g)[from_node];
+    size_t pos = _cds_list_find(row, to_node);
+
+    if (pos == CDS_VECTOR_NPOS) {
+        return false;
+    }
+
+    *out = row->weights != NULL ? ((double*) cds_vector_data(row->weights))[pos] : 1;
+    return true;
+}
+
+int _cds_list_add_node(cds_graph* g) {
+    if (g->nodes == INT_MAX) {
+        return -1;
+    }
+
+    struct _cds_list_row* row = cds_vector_emplace_back(g->rows);
+    if (row == NULL) {
+        return -1;
+    }
+
+    *row = (struct _cds_list_row) {0};
+    return g->nodes++;
+}
+
+size_t _cds_list_out_degree(cds_graph* g, unsigned int node) {
+    return cds_vector_size(_cds_list_rows(g)[node].targets);
+}
+
+static struct _cds_list_row* _cds_list_rows(cds_graph* g) {
+    return cds_vector_data(g->rows);
+}
+
+static size_t _cds_list_find(struct _cds_list_row* row, unsigned int to_node) {
+    if (row->targets == NULL) {
+        return CDS_VECTOR_NPOS;
+    }
+
+    // node ids fit in an int, so a vectorized int scan finds them
+    return cds_vector_find_i32(row->targets, (int32_t) to_node);
+}
+
+static int _cds_list_weigh(struct _cds_list_row* row) {
+    double one = 1;
+
+    row->weights = cds_vector_create((struct cds_vector_config) {
+        .type = sizeof(double),
+        .capacity = cds_vector_capacity(row->targets),
+        .memory = cds_memory_system()
+    });
+
+    if (row->weights == NULL || cds_vector_resize(row->weights, cds_vector_size(row->targets), &one) != CDS_OK) {
+        cds_vector_destroy(row->weights);
+        row->weights = NULL;
+        return CDS_ERR;
+    }
+
+    return CDS_OK;
+}
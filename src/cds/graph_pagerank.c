@@ -0,0 +1,188 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph_internal.h"
+#include "pool.h"
+
+// below it a single thread beats waking the pool every iteration
+#define _CDS_PAGERANK_PARALLEL 4096
+// stop even if scores keep moving
+#define _CDS_PAGERANK_ITERATIONS 1000
+#define _CDS_PAGERANK_ALIGN 64
+
+// per worker sums, one cache line each so workers don't share lines
+struct _cds_pagerank_partial {
+    double delta;
+    double dangling;
+    char padding[_CDS_PAGERANK_ALIGN - 2 * sizeof(double)];
+};
+
+struct _cds_spmv_job {
+    // in-edges, pulling from them needs no atomics
+    const struct _cds_graph_view* reverse;
+    // first row of every worker, rows are split by edge count
+    const size_t* bounds;
+
+    // next = base + scale * (reverse * contrib)
+    const double* contrib;
+    double* next;
+    double base;
+    double scale;
+
+    // contrib of next iteration, scores divided by out-degree
+    const double* inverse_degree;
+    double* next_contrib;
+    const double* previous;
+
+    struct _cds_pagerank_partial* partial;
+};
+
+static void _cds_spmv_pull(void* context, size_t index, size_t count);
+static double* _cds_pagerank_buffer(size_t nodes);
+
+int cds_graph_pagerank(cds_graph* g, double damping, double tol, size_t nthreads, double* scores_out) {
+    if (g == NULL || scores_out == NULL || !(damping >= 0 && damping < 1) || !(tol > 0)) {
+        return CDS_ERR;
+    }
+    if (g->nodes == 0) {
+        return CDS_OK;
+    }
+
+    struct _cds_graph_view graph, reverse = {0};
+    if (_cds_graph_view(g, &graph, false) != CDS_OK) {
+        return CDS_ERR;
+    }
+
+    size_t nodes = graph.nodes;
+    size_t threads = nodes < _CDS_PAGERANK_PARALLEL ? 1 : _cds_pool_threads(nthreads);
+
+    // contiguous double buffers, swapped after every iteration
+    double* rank = _cds_pagerank_buffer(nodes);
+    double* next = _cds_pagerank_buffer(nodes);
+    double* contrib = _cds_pagerank_buffer(nodes);
+    double* next_contrib = _cds_pagerank_buffer(nodes);
+    double* inverse_degree = _cds_pagerank_buffer(nodes);
+    size_t* bounds = malloc(sizeof(size_t) * (threads + 1));
+    struct _cds_pagerank_partial* partial = aligned_alloc(_CDS_PAGERANK_ALIGN, sizeof(struct _cds_pagerank_partial) * threads);
+    _cds_pool pool = _cds_pool_create(threads);
+
+    int status = CDS_ERR;
+    if (rank == NULL || next == NULL || contrib == NULL || next_contrib == NULL || inverse_degree == NULL
+        || bounds == NULL || partial == NULL || pool == NULL
+        || _cds_graph_view_transpose(&graph, &reverse) != CDS_OK) {
+        goto cleanup;
+    }
+
+    // pool may have fewer workers than asked for
+    threads = _cds_pool_size(pool);
+    // ranges start at row holding their first in-edge, first and last are
+    // pinned so rows without in-edges at either end are still written; with
+    // no edges at all rows are split evenly
+    bounds[0] = 0;
+    bounds[threads] = nodes;
+    for (size_t worker = 1; worker < threads; worker++) {
+        size_t begin, end;
+        _cds_pool_split(reverse.edges != 0 ? reverse.edges : nodes, worker, threads, &begin, &end);
+        bounds[worker] = reverse.edges != 0 ? _cds_graph_view_row(&reverse, begin) : begin;
+    }
+
+    double dangling = 0;
+    for (size_t node = 0; node < nodes; node++) {
+        size_t degree = graph.offsets[node + 1] - graph.offsets[node];
+
+        rank[node] = 1.0 / (double) nodes;
+        inverse_degree[node] = degree != 0 ? 1.0 / (double) degree : 0;
+        contrib[node] = rank[node] * inverse_degree[node];
+        dangling += degree == 0 ? rank[node] : 0;
+    }
+
+    struct _cds_spmv_job job = {
+        .reverse = &reverse,
+        .bounds = bounds,
+        .scale = damping,
+        .inverse_degree = inverse_degree,
+        .partial = partial
+    };
+
+    for (size_t iteration = 0; iteration < _CDS_PAGERANK_ITERATIONS; iteration++) {
+        // teleport and rank of dangling nodes are spread to everyone
+        job.base = (1 - damping) / (double) nodes + damping * dangling / (double) nodes;
+        job.contrib = contrib;
+        job.next = next;
+        job.next_contrib = next_contrib;
+        job.previous = rank;
+
+        _cds_pool_run(pool, _cds_spmv_pull, &job);
+
+        double delta = 0;
+        dangling = 0;
+        for (size_t worker = 0; worker < threads; worker++) {
+            delta += partial[worker].delta;
+            dangling += partial[worker].dangling;
+        }
+
+        double* swap = rank;
+        rank = next;
+        next = swap;
+        swap = contrib;
+        contrib = next_contrib;
+        next_contrib = swap;
+
+        if (delta < tol) {
+            break;
+        }
+    }
+
+    memcpy(scores_out, rank, sizeof(double) * nodes);
+    status = CDS_OK;
+
+cleanup:
+    _cds_pool_destroy(pool);
+    _cds_graph_view_release(&reverse);
+    _cds_graph_view_release(&graph);
+
+    free(rank);
+    free(next);
+    free(contrib);
+    free(next_contrib);
+    free(inverse_degree);
+    free(bounds);
+    free(partial);
+
+    return status;
+}
+
+static void _cds_spmv_pull(void* context, size_t index, size_t count) {
+    (void) count;
+
+    struct _cds_spmv_job* job = context;
+    const size_t* offsets = job->reverse->offsets;
+    const unsigned int* sources = job->reverse->targets;
+
+    double delta = 0, dangling = 0;
+
+    // every worker writes only its own rows
+    for (size_t node = job->bounds[index]; node < job->bounds[index + 1]; node++) {
+        double sum = 0;
+
+        for (size_t e = offsets[node]; e < offsets[node + 1]; e++) {
+            sum += job->contrib[sources[e]];
+        }
+
+        double score = job->base + job->scale * sum;
+
+        job->next[node] = score;
+        job->next_contrib[node] = score * job->inverse_degree[node];
+        delta += fabs(score - job->previous[node]);
+        dangling += job->inverse_degree[node] == 0 ? score : 0;
+    }
+
+    job->partial[index].delta = delta;
+    job->partial[index].dangling = dangling;
+}
+
+static double* _cds_pagerank_buffer(size_t nodes) {
+    size_t bytes = (sizeof(double) * nodes + _CDS_PAGERANK_ALIGN - 1) / _CDS_PAGERANK_ALIGN * _CDS_PAGERANK_ALIGN;
+    return aligned_alloc(_CDS_PAGERANK_ALIGN, bytes);
+}
@@ -0,0 +1,303 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/vector.h>
+
+#include "graph_internal.h"
+
+static int _cds_reorder_degree(const struct _cds_graph_view* graph, const struct _cds_graph_view* reverse, unsigned int* order);
+static int _cds_reorder_bfs(const struct _cds_graph_view* graph, const struct _cds_graph_view* reverse, unsigned int* order, bool cuthill);
+static unsigned int* _cds_reorder_by_degree(const struct _cds_graph_view* graph, const struct _cds_graph_view* reverse, bool descending);
+static size_t _cds_reorder_degree_of(const struct _cds_graph_view* graph, const struct _cds_graph_view* reverse, size_t node);
+static cds_graph* _cds_reorder_build(cds_graph* g, const struct _cds_graph_view* graph, const unsigned int* order, const unsigned int* perm);
+static int _cds_key_cmp(const void* a, const void* b);
+static int _cds_reorder_target_cmp(const void* a, const void* b);
+
+cds_graph* cds_graph_reorder(cds_graph* g, enum cds_graph_order strategy, unsigned int* perm_out) {
+    if (g == NULL || perm_out == NULL || strategy > CDS_GRAPH_ORDER_BFS) {
+        return NULL;
+    }
+
+    struct _cds_graph_view graph, reverse = {0};
+    if (_cds_graph_view(g, &graph, true) != CDS_OK) {
+        return NULL;
+    }
+
+    size_t nodes = graph.nodes;
+    // order[new] is old id, perm_out[old] is new one
+    unsigned int* order = malloc(sizeof(unsigned int) * (nodes + 1));
+    cds_graph* result = NULL;
+
+    // locality is about both directions, traversals follow in and out edges
+    if (order == NULL || _cds_graph_view_transpose(&graph, &reverse) != CDS_OK) {
+        goto cleanup;
+    }
+
+    int status;
+    switch (strategy) {
+        case CDS_GRAPH_ORDER_DEGREE:
+            status = _cds_reorder_degree(&graph, &reverse, order);
+            break;
+        case CDS_GRAPH_ORDER_RCM:
+            status = _cds_reorder_bfs(&graph, &reverse, order, true);
+            break;
+        default:
+            status = _cds_reorder_bfs(&graph, &reverse, order, false);
+            break;
+    }
+
+    if (status != CDS_OK) {
+        goto cleanup;
+    }
+
+    for (size_t node = 0; node < nodes; node++) {
+        perm_out[order[node]] = (unsigned int) node;
+    }
+
+    result = _cds_reorder_build(g, &graph, order, perm_out);
+
+cleanup:
+    free(order);
+    _cds_graph_view_release(&reverse);
+    _cds_graph_view_release(&graph);
+
+    return result;
+}
+
+static int _cds_reorder_degree(const struct _cds_graph_view* graph, const struct _cds_graph_view* reverse, unsigned int* order) {
+    unsigned int* sorted = _cds_reorder_by_degree(graph, reverse, true);
+    if (sorted == NULL) {
+        return CDS_ERR;
+    }
+
+    memcpy(order, sorted, sizeof(unsigned int) * graph->nodes);
+    free(sorted);
+
+    return CDS_OK;
+}
+
+static int _cds_reorder_bfs(const struct _cds_graph_view* graph, const struct _cds_graph_view* reverse, unsigned int* order, bool cuthill) {
+    size_t nodes = graph->nodes;
+
+    // Cuthill-McKee starts every component at its lowest degree node
+    unsigned int* starts = cuthill ? _cds_reorder_by_degree(graph, reverse, false) : NULL;
+    bool* visited = calloc(nodes + 1, sizeof(bool));
+    uint64_t* keys = cuthill ? malloc(sizeof(uint64_t) * (nodes + 1)) : NULL;
+
+    if (visited == NULL || (cuthill && (starts == NULL || keys == NULL))) {
+        free(starts);
+        free(visited);
+        free(keys);
+        return CDS_ERR;
+    }
+
+    // order doubles as queue, nodes are numbered as they are enqueued
+    size_t head = 0, tail = 0;
+
+    for (size_t i = 0; i < nodes; i++) {
+        unsigned int start = cuthill ? starts[i] : (unsigned int) i;
+        if (visited[start]) {
+            continue;
+        }
+
+        visited[start] = true;
+        order[tail++] = start;
+
+        while (head < tail) {
+            unsigned int node = order[head++];
+            size_t first = tail;
+
+            for (int side = 0; side < 2; side++) {
+                const struct _cds_graph_view* edges = side == 0 ? graph : reverse;
+
+                for (size_t e = edges->offsets[node]; e < edges->offsets[node + 1]; e++) {
+                    unsigned int neighbor = edges->targets[e];
+
+                    if (!visited[neighbor]) {
+                        visited[neighbor] = true;
+                        order[tail++] = neighbor;
+                    }
+                }
+            }
+
+            if (!cuthill || tail - first < 2) {
+                continue;
+            }
+
+            // children are numbered by increasing degree, ties by id
+            for (size_t j = first; j < tail; j++) {
+                keys[j - first] = (uint64_t) _cds_reorder_degree_of(graph, reverse, order[j]) << 32 | order[j];
+            }
+            qsort(keys, tail - first, sizeof(uint64_t), _cds_key_cmp);
+            for (size_t j = first; j < tail; j++) {
+                order[j] = (unsigned int) keys[j - first];
+            }
+        }
+    }
+
+    // reversing Cuthill-McKee order keeps bandwidth and shrinks fill
+    if (cuthill) {
+        for (size_t i = 0; i < nodes / 2; i++) {
+            unsigned int swap = order[i];
+            order[i] = order[nodes - 1 - i];
+            order[nodes - 1 - i] = swap;
+        }
+    }
+
+    free(starts);
+    free(visited);
+    free(keys);
+
+    return CDS_OK;
+}
+
+// nodes sorted by in plus out degree with a counting sort, ties by id
+static unsigned int* _cds_reorder_by_degree(const struct _cds_graph_view* graph, const struct _cds_graph_view* reverse, bool descending) {
+    size_t nodes = graph->nodes;
+    size_t max = 0;
+
+    for (size_t node = 0; node < nodes; node++) {
+        size_t degree = _cds_reorder_degree_of(graph, reverse, node);
+        max = degree > max ? degree : max;
+    }
+
+    unsigned int* sorted = malloc(sizeof(unsigned int) * (nodes + 1));
+    size_t* start = calloc(max + 2, sizeof(size_t));
+
+    if (sorted == NULL || start == NULL) {
+        free(sorted);
+        free(start);
+        return NULL;
+    }
+
+    for (size_t node = 0; node < nodes; node++) {
+        size_t degree = _cds_reorder_degree_of(graph, reverse, node);
+        start[(descending ? max - degree : degree) + 1]++;
+    }
+    for (size_t bucket = 0; bucket <= max; bucket++) {
+        start[bucket + 1] += start[bucket];
+    }
+    for (size_t node = 0; node < nodes; node++) {
+        size_t degree = _cds_reorder_degree_of(graph, reverse, node);
+        sorted[start[descending ? max - degree : degree]++] = (unsigned int) node;
+    }
+
+    free(start);
+    return sorted;
+}
+
+static size_t _cds_reorder_degree_of(const struct _cds_graph_view* graph, const struct _cds_graph_view* reverse, size_t node) {
+    return graph->offsets[node + 1] - graph->offsets[node] + reverse->offsets[node + 1] - reverse->offsets[node];
+}
+
+static cds_graph* _cds_reorder_build(cds_graph* g, const struct _cds_graph_view* graph, const unsigned int* order, const unsigned int* perm) {
+    size_t nodes = graph->nodes;
+
+    if (g->kind == CDS_GRAPH_MATRIX) {
+        cds_graph* result = cds_create_graph(g->nodes);
+
+        for (size_t node = 0; result != NULL && node < nodes; node++) {
+            uint64_t* row = _CDS_MATRIX_ROW(result, perm[node]);
+
+            for (size_t e = graph->offsets[node]; e < graph->offsets[node + 1]; e++) {
+                row[perm[graph->targets[e]] / 64] |= UINT64_C(1) << (perm[graph->targets[e]] % 64);
+            }
+        }
+
+        return result;
+    }
+
+    if (g->kind == CDS_GRAPH_LIST) {
+        cds_graph* result = cds_create_list_graph(g->nodes);
+        if (result == NULL) {
+            return NULL;
+        }
+
+        struct _cds_list_row* rows = cds_vector_data(result->rows);
+        for (size_t node = 0; node < nodes; node++) {
+            size_t old = order[node];
+            size_t begin = graph->offsets[old];
+            size_t degree = graph->offsets[old + 1] - begin;
+
+            if (degree == 0) {
+                continue;
+            }
+
+            // rows keep their edge order, so weights stay next to targets
+            struct cds_vector_config config = {.type = sizeof(unsigned int), .capacity = degree, .memory = cds_memory_system()};
+            rows[node].targets = cds_vector_create(config);
+
+            if (rows[node].targets == NULL || cds_vector_resize(rows[node].targets, degree, NULL) != CDS_OK) {
+                cds_destroy_graph(result);
+                return NULL;
+            }
+
+            unsigned int* targets = cds_vector_data(rows[node].targets);
+            for (size_t i = 0; i < degree; i++) {
+                targets[i] = perm[graph->targets[begin + i]];
+            }
+
+            bool weighted = false;
+            for (size_t i = 0; graph->weights != NULL && i < degree; i++) {
+                weighted |= graph->weights[begin + i] != 1;
+            }
+
+            if (weighted) {
+                config.type = sizeof(double);
+                rows[node].weights = cds_vector_create(config);
+
+                if (rows[node].weights == NULL || cds_vector_append_n(rows[node].weights, (double*) &graph->weights[begin], degree) != CDS_OK) {
+                    cds_destroy_graph(result);
+                    return NULL;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    cds_graph* result = calloc(1, sizeof(cds_graph));
+    if (result == NULL) {
+        return NULL;
+    }
+
+    result->nodes = g->nodes;
+    result->kind = CDS_GRAPH_CSR;
+    result->offsets = malloc(sizeof(size_t) * (nodes + 1));
+    result->targets = malloc(sizeof(unsigned int) * (graph->edges != 0 ? graph->edges : 1));
+    result->capacity = graph->edges;
+
+    if (result->offsets == NULL || result->targets == NULL) {
+        cds_destroy_graph(result);
+        return NULL;
+    }
+
+    // rows are copied in new order, renamed and sorted again
+    size_t written = 0;
+    for (size_t node = 0; node < nodes; node++) {
+        size_t old = order[node];
+
+        result->offsets[node] = written;
+        for (size_t e = graph->offsets[old]; e < graph->offsets[old + 1]; e++) {
+            result->targets[written++] = perm[graph->targets[e]];
+        }
+        qsort(&result->targets[result->offsets[node]], written - result->offsets[node], sizeof(unsigned int), _cds_reorder_target_cmp);
+    }
+    result->offsets[nodes] = written;
+
+    return result;
+}
+
+static int _cds_key_cmp(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*) a;
+    uint64_t y = *(const uint64_t*) b;
+
+    return (x > y) - (x < y);
+}
+
+static int _cds_reorder_target_cmp(const void* a, const void* b) {
+    unsigned int x = *(const unsigned int*) a;
+    unsigned int y = *(const unsigned int*) b;
+
+    return (x > y) - (x < y);
+}
@@ -0,0 +1,171 @@
+#include <stdlib.h>
+
+#include <cds/vector.h>
+
+#include "graph_internal.h"
+
+// a DFS call, edge is next out-edge of node to look at
+struct _cds_scc_frame {
+    unsigned int node;
+    size_t edge;
+};
+
+static cds_vector _cds_scc_stack(size_t type, size_t nodes);
+
+int cds_graph_scc(cds_graph* g, unsigned int* labels_out) {
+    if (g == NULL || labels_out == NULL) {
+        return CDS_ERR;
+    }
+
+    struct _cds_graph_view graph;
+    if (_cds_graph_view(g, &graph, false) != CDS_OK) {
+        return CDS_ERR;
+    }
+
+    size_t nodes = graph.nodes;
+    unsigned int* index = malloc(sizeof(unsigned int) * nodes * 2 + 1);
+    unsigned int* low = &index[nodes];
+    // both stacks hold each node at most once, they never grow
+    cds_vector calls = _cds_scc_stack(sizeof(struct _cds_scc_frame), nodes);
+    cds_vector stack = _cds_scc_stack(sizeof(unsigned int), nodes);
+
+    int status = CDS_ERR;
+    if (index == NULL || calls == NULL || stack == NULL) {
+        goto cleanup;
+    }
+
+    // labels_out marks finished nodes, visited ones without label are on stack
+    for (size_t node = 0; node < nodes; node++) {
+        index[node] = CDS_GRAPH_UNREACHED;
+        labels_out[node] = CDS_GRAPH_UNREACHED;
+    }
+
+    unsigned int visited = 0, found = 0;
+
+    for (unsigned int root = 0; root < nodes; root++) {
+        if (index[root] != CDS_GRAPH_UNREACHED) {
+            continue;
+        }
+
+        index[root] = low[root] = visited++;
+        cds_vector_pushback(stack, &root);
+        cds_vector_pushback(calls, &(struct _cds_scc_frame) {.node = root, .edge = graph.offsets[root]});
+
+        while (cds_vector_size(calls) != 0) {
+            struct _cds_scc_frame* frame = cds_vector_ptr_at(calls, cds_vector_size(calls) - 1);
+            unsigned int node = frame->node;
+
+            if (frame->edge < graph.offsets[node + 1]) {
+                unsigned int neighbor = graph.targets[frame->edge++];
+
+                if (index[neighbor] == CDS_GRAPH_UNREACHED) {
+                    // descend, frame of neighbor resumes before node's does
+                    index[neighbor] = low[neighbor] = visited++;
+                    cds_vector_pushback(stack, &neighbor);
+                    cds_vector_pushback(calls, &(struct _cds_scc_frame) {.node = neighbor, .edge = graph.offsets[neighbor]});
+                } else if (labels_out[neighbor] == CDS_GRAPH_UNREACHED && index[neighbor] < low[node]) {
+                    low[node] = index[neighbor];
+                }
+                continue;
+            }
+
+            cds_vector_popback(calls, NULL);
+
+            // node is root of a component, everything above it on stack belongs to it
+            if (low[node] == index[node]) {
+                unsigned int member;
+                do {
+                    cds_vector_popback(stack, &member);
+                    labels_out[member] = found;
+                } while (member != node);
+                found++;
+            }
+
+            if (cds_vector_size(calls) != 0) {
+                struct _cds_scc_frame* caller = cds_vector_ptr_at(calls, cds_vector_size(calls) - 1);
+
+                if (low[node] < low[caller->node]) {
+                    low[caller->node] = low[node];
+                }
+            }
+        }
+    }
+
+    // components are found sinks first, flip them into topological order
+    for (size_t node = 0; node < nodes; node++) {
+        labels_out[node] = found - 1 - labels_out[node];
+    }
+
+    status = CDS_OK;
+
+cleanup:
+    cds_vector_destroy(stack);
+    cds_vector_destroy(calls);
+    free(index);
+    _cds_graph_view_release(&graph);
+
+    return status;
+}
+
+int cds_graph_toposort(cds_graph* g, unsigned int* order_out) {
+    if (g == NULL || order_out == NULL) {
+        return CDS_ERR;
+    }
+
+    struct _cds_graph_view graph;
+    if (_cds_graph_view(g, &graph, false) != CDS_OK) {
+        return CDS_ERR;
+    }
+
+    size_t nodes = graph.nodes;
+    unsigned int* indegree = calloc(nodes + 1, sizeof(unsigned int));
+    cds_vector ready = _cds_scc_stack(sizeof(unsigned int), nodes);
+
+    int status = CDS_ERR;
+    if (indegree == NULL || ready == NULL) {
+        goto cleanup;
+    }
+
+    for (size_t e = 0; e < graph.edges; e++) {
+        indegree[graph.targets[e]]++;
+    }
+
+    // pushed backwards so that lowest ready node comes out first
+    for (size_t node = nodes; node-- > 0;) {
+        if (indegree[node] == 0) {
+            cds_vector_pushback(ready, &(unsigned int) {(unsigned int) node});
+        }
+    }
+
+    size_t sorted = 0;
+    unsigned int node;
+
+    while (cds_vector_popback(ready, &node) == CDS_OK) {
+        order_out[sorted++] = node;
+
+        for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+            if (--indegree[graph.targets[e]] == 0) {
+                cds_vector_pushback(ready, (unsigned int*) &graph.targets[e]);
+            }
+        }
+    }
+
+    // nodes left over all lie on or behind a cycle
+    status = sorted == nodes ? CDS_OK : CDS_ERR;
+
+cleanup:
+    cds_vector_destroy(ready);
+    free(indegree);
+    _cds_graph_view_release(&graph);
+
+    return status;
+}
+
+static cds_vector _cds_scc_stack(size_t type, size_t nodes) {
+    return cds_vector_create((struct cds_vector_config) {
+        .type = type,
+        .capacity = nodes + 1,
+        .memory = cds_memory_system(),
+        .never_shrink = true
+    });
+}
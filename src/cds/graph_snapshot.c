@@ -0,0 +1,229 @@
+#include <assert.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define _CDS_MMAP 1
+#endif
+
+#include "graph_internal.h"
+
+// sections start at multiples of it, so each one is page aligned
+#define _CDS_SNAPSHOT_PAGE ((uint64_t) 4096)
+#define _CDS_SNAPSHOT_ROUND(bytes) (((bytes) + _CDS_SNAPSHOT_PAGE - 1) / _CDS_SNAPSHOT_PAGE * _CDS_SNAPSHOT_PAGE)
+#define _CDS_SNAPSHOT_VERSION 1
+
+// header of a snapshot, in native byte order, it takes the whole first page;
+// nodes + 1 uint64_t offsets and edges uint32_t targets follow at given
+// positions
+struct _cds_graph_snapshot {
+    char magic[8];
+    uint32_t version;
+    uint32_t unused;
+    uint64_t nodes;
+    uint64_t edges;
+    uint64_t offsets_at;
+    uint64_t targets_at;
+    uint64_t length;
+};
+
+// rows are mapped in place, so file and memory layout have to be the same
+static_assert(sizeof(size_t) == sizeof(uint64_t), "snapshot offsets are 64 bits");
+static_assert(sizeof(unsigned int) == sizeof(uint32_t), "snapshot targets are 32 bits");
+
+static bool _cds_snapshot_pad(FILE* file, uint64_t bytes);
+static bool _cds_snapshot_offsets(const size_t* offsets, size_t nodes, size_t edges);
+static bool _cds_snapshot_valid(const size_t* offsets, const unsigned int* targets, size_t nodes);
+
+int cds_graph_save_snapshot(cds_graph* g, const char* path) {
+    if (g == NULL || path == NULL) {
+        return CDS_ERR;
+    }
+
+    struct _cds_graph_view graph;
+    if (_cds_graph_view(g, &graph, false) != CDS_OK) {
+        return CDS_ERR;
+    }
+    // rows of snapshots are binary searched
+    _cds_graph_view_sort(&graph);
+
+    // written next to target and renamed, mapped readers keep the old inode
+    size_t length = strlen(path);
+    char* temporary = malloc(length + sizeof(".tmp"));
+    FILE* file = NULL;
+
+    if (temporary != NULL) {
+        memcpy(temporary, path, length);
+        memcpy(&temporary[length], ".tmp", sizeof(".tmp"));
+        file = fopen(temporary, "wb");
+    }
+
+    if (file == NULL) {
+        free(temporary);
+        _cds_graph_view_release(&graph);
+        return CDS_ERR;
+    }
+
+    struct _cds_graph_snapshot header = {
+        .magic = "CDSGRPH",
+        .version = _CDS_SNAPSHOT_VERSION,
+        .nodes = graph.nodes,
+        .edges = graph.edges,
+        .offsets_at = _CDS_SNAPSHOT_PAGE
+    };
+    uint64_t offsets_end = header.offsets_at + sizeof(uint64_t) * (graph.nodes + 1);
+    uint64_t targets_end;
+
+    header.targets_at = _CDS_SNAPSHOT_ROUND(offsets_end);
+    targets_end = header.targets_at + sizeof(uint32_t) * graph.edges;
+    header.length = _CDS_SNAPSHOT_ROUND(targets_end);
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+        && _cds_snapshot_pad(file, header.offsets_at - sizeof(header))
+        && fwrite(graph.offsets, sizeof(size_t), graph.nodes + 1, file) == graph.nodes + 1
+        && _cds_snapshot_pad(file, header.targets_at - offsets_end)
+        && fwrite(graph.targets, sizeof(unsigned int), graph.edges, file) == graph.edges
+        && _cds_snapshot_pad(file, header.length - targets_end);
+
+    _cds_graph_view_release(&graph);
+
+    if (fclose(file) != 0 || !written || rename(temporary, path) != 0) {
+        remove(temporary);
+        free(temporary);
+        return CDS_ERR;
+    }
+
+    free(temporary);
+    return CDS_OK;
+}
+
+cds_graph* cds_graph_open_mapped(const char* path, bool verify) {
+#ifdef _CDS_MMAP
+    if (path == NULL) {
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || (uint64_t) status.st_size < _CDS_SNAPSHOT_PAGE) {
+        close(fd);
+        return NULL;
+    }
+
+    // shared read-only pages, every process mapping the file uses one copy
+    size_t length = (size_t) status.st_size;
+    uint8_t* base = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+
+    struct _cds_graph_snapshot header;
+    memcpy(&header, base, sizeof(header));
+
+    bool valid = memcmp(header.magic, "CDSGRPH", sizeof("CDSGRPH")) == 0
+        && header.version == _CDS_SNAPSHOT_VERSION
+        && header.nodes <= INT_MAX
+        && header.length <= length
+        && header.offsets_at % _CDS_SNAPSHOT_PAGE == 0
+        && header.targets_at % _CDS_SNAPSHOT_PAGE == 0
+        && header.offsets_at >= _CDS_SNAPSHOT_PAGE
+        && header.offsets_at <= header.length
+        && (header.length - header.offsets_at) / sizeof(uint64_t) > header.nodes
+        && header.targets_at <= header.length
+        && (header.length - header.targets_at) / sizeof(uint32_t) >= header.edges;
+
+    const size_t* offsets = valid ? (const size_t*) (base + header.offsets_at) : NULL;
+    const unsigned int* targets = valid ? (const unsigned int*) (base + header.targets_at) : NULL;
+
+    // monotonic offsets bounded by edges keep every row inside the mapping,
+    // a full check also reads every target
+    valid = valid && _cds_snapshot_offsets(offsets, header.nodes, header.edges);
+    if (valid && verify) {
+        valid = _cds_snapshot_valid(offsets, targets, header.nodes);
+    }
+
+    cds_graph* g = valid ? calloc(1, sizeof(cds_graph)) : NULL;
+    if (g == NULL) {
+        munmap(base, length);
+        return NULL;
+    }
+
+    g->nodes = (int) header.nodes;
+    g->kind = CDS_GRAPH_CSR;
+    g->offsets = (size_t*) offsets;
+    g->targets = (unsigned int*) targets;
+    g->capacity = header.edges;
+    g->mapping = base;
+    g->mapped = length;
+
+    return g;
+#else
+    (void) verify;
+    return NULL;
+#endif
+}
+
+bool cds_graph_readonly(cds_graph* g) {
+    return g != NULL && g->mapping != NULL;
+}
+
+void _cds_snapshot_release(cds_graph* g) {
+#ifdef _CDS_MMAP
+    munmap(g->mapping, g->mapped);
+#endif
+    free(g);
+}
+
+static bool _cds_snapshot_pad(FILE* file, uint64_t bytes) {
+    static const uint8_t zeros[_CDS_SNAPSHOT_PAGE] = {0};
+
+    while (bytes != 0) {
+        size_t count = bytes < sizeof(zeros) ? (size_t) bytes : sizeof(zeros);
+
+        if (fwrite(zeros, 1, count, file) != count) {
+            return false;
+        }
+        bytes -= count;
+    }
+
+    return true;
+}
+
+static bool _cds_snapshot_offsets(const size_t* offsets, size_t nodes, size_t edges) {
+    if (offsets[0] != 0 || offsets[nodes] != edges) {
+        return false;
+    }
+
+    for (size_t node = 0; node < nodes; node++) {
+        if (offsets[node] > offsets[node + 1]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool _cds_snapshot_valid(const size_t* offsets, const unsigned int* targets, size_t nodes) {
+    for (size_t node = 0; node < nodes; node++) {
+        // binary searches need rows sorted without repeats
+        for (size_t e = offsets[node]; e < offsets[node + 1]; e++) {
+            if (targets[e] >= nodes || (e != offsets[node] && targets[e] <= targets[e - 1])) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,533 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/vector.h>
+
+#include "graph_internal.h"
+#include "pool.h"
+
+// heap nodes have 4 children, 16-byte entries put all of them in one line
+#define _CDS_HEAP_ARITY 4
+#define _CDS_HEAP_PAD 3
+// below it Dijkstra beats waking the pool every phase
+#define _CDS_SSSP_PARALLEL 4096
+// cyclic bucket array is never larger than this
+#define _CDS_SSSP_BUCKETS ((size_t) 1 << 20)
+
+struct _cds_heap_entry {
+    double dist;
+    unsigned int node;
+};
+
+struct _cds_sssp_job {
+    const struct _cds_graph_view* graph;
+    // non-negative doubles order like their bits, so dist is kept as bits
+    uint64_t* dist;
+    unsigned int* pred;
+    unsigned int source;
+    double delta;
+    bool light;
+
+    const unsigned int* frontier;
+    size_t frontier_size;
+
+    // per worker nodes whose distance improved
+    cds_vector* updated;
+    bool failed;
+};
+
+static int _cds_sssp_check(const struct _cds_graph_view* graph, double* max_weight, bool* zero_weight);
+static int _cds_heap_push(cds_vector heap, double dist, unsigned int node);
+static struct _cds_heap_entry _cds_heap_pop(cds_vector heap);
+static void _cds_sssp_relax(void* context, size_t index, size_t count);
+static void _cds_sssp_pred(void* context, size_t index, size_t count);
+static int _cds_sssp_tight(const struct _cds_graph_view* graph, unsigned int source, const uint64_t* dist, unsigned int* pred);
+static size_t _cds_sssp_bucket(uint64_t bits, double delta);
+static double _cds_sssp_weight(const struct _cds_graph_view* graph, size_t edge);
+
+int cds_graph_sssp(cds_graph* g, unsigned int source, double* dist_out, unsigned int* pred_out) {
+    if (g == NULL || source >= (unsigned int) g->nodes) {
+        return CDS_ERR;
+    }
+
+    struct _cds_graph_view graph;
+    if (_cds_graph_view(g, &graph, true) != CDS_OK) {
+        return CDS_ERR;
+    }
+
+    double max_weight;
+    bool zero_weight;
+    size_t nodes = graph.nodes;
+    double* dist = dist_out != NULL ? dist_out : malloc(sizeof(double) * nodes);
+    cds_vector heap = cds_vector_create((struct cds_vector_config) {
+        .type = sizeof(struct _cds_heap_entry),
+        .capacity = nodes + _CDS_HEAP_PAD,
+        .memory = cds_memory_system(),
+        .alignment = sizeof(struct _cds_heap_entry) * _CDS_HEAP_ARITY,
+        // heap is sized for every node up front, pops must not reallocate
+        .never_shrink = true
+    });
+
+    int status = CDS_ERR;
+    if (dist == NULL || heap == NULL || _cds_sssp_check(&graph, &max_weight, &zero_weight) != CDS_OK) {
+        goto cleanup;
+    }
+
+    // padding puts the children of every entry in a single cache line
+    if (cds_vector_resize(heap, _CDS_HEAP_PAD, NULL) != CDS_OK) {
+        goto cleanup;
+    }
+
+    for (size_t node = 0; node < nodes; node++) {
+        dist[node] = INFINITY;
+        if (pred_out != NULL) {
+            pred_out[node] = CDS_GRAPH_UNREACHED;
+        }
+    }
+    dist[source] = 0;
+    if (pred_out != NULL) {
+        pred_out[source] = source;
+    }
+
+    // entries are not decreased, stale ones are skipped when popped
+    if (_cds_heap_push(heap, 0, source) != CDS_OK) {
+        goto cleanup;
+    }
+
+    while (cds_vector_size(heap) > _CDS_HEAP_PAD) {
+        struct _cds_heap_entry top = _cds_heap_pop(heap);
+        if (top.dist > dist[top.node]) {
+            continue;
+        }
+
+        for (size_t e = graph.offsets[top.node]; e < graph.offsets[top.node + 1]; e++) {
+            unsigned int neighbor = graph.targets[e];
+            double candidate = top.dist + _cds_sssp_weight(&graph, e);
+
+            if (candidate < dist[neighbor]) {
+                dist[neighbor] = candidate;
+                if (pred_out != NULL) {
+                    pred_out[neighbor] = top.node;
+                }
+                if (_cds_heap_push(heap, candidate, neighbor) != CDS_OK) {
+                    goto cleanup;
+                }
+            }
+        }
+    }
+
+    status = CDS_OK;
+
+cleanup:
+    if (dist != dist_out) {
+        free(dist);
+    }
+    cds_vector_destroy(heap);
+    _cds_graph_view_release(&graph);
+
+    return status;
+}
+
+int cds_graph_sssp_parallel(cds_graph* g, unsigned int source, double* dist_out, unsigned int* pred_out, double delta, size_t nthreads) {
+    if (g == NULL || source >= (unsigned int) g->nodes || !(delta >= 0)) {
+        return CDS_ERR;
+    }
+
+    size_t threads = _cds_pool_threads(nthreads);
+    if (threads == 1 || g->nodes < _CDS_SSSP_PARALLEL) {
+        return cds_graph_sssp(g, source, dist_out, pred_out);
+    }
+
+    struct _cds_graph_view graph;
+    if (_cds_graph_view(g, &graph, true) != CDS_OK) {
+        return CDS_ERR;
+    }
+
+    double max_weight;
+    bool zero_weight;
+    size_t nodes = graph.nodes;
+    int status = CDS_ERR;
+
+    uint64_t* dist = malloc(sizeof(uint64_t) * nodes);
+    size_t* seen = malloc(sizeof(size_t) * nodes);
+    cds_vector frontier = cds_vector_create((struct cds_vector_config) {
+        .type = sizeof(unsigned int),
+        .memory = cds_memory_system()
+    });
+    cds_vector settled = cds_vector_create((struct cds_vector_config) {
+        .type = sizeof(unsigned int),
+        .memory = cds_memory_system()
+    });
+    cds_vector* buckets = NULL;
+    size_t bucket_count = 0;
+    _cds_pool pool = _cds_pool_create(threads);
+    cds_vector* updated = calloc(_cds_pool_size(pool), sizeof(cds_vector));
+
+    if (dist == NULL || seen == NULL || frontier == NULL || settled == NULL || pool == NULL || updated == NULL
+        || _cds_sssp_check(&graph, &max_weight, &zero_weight) != CDS_OK) {
+        goto cleanup;
+    }
+
+    // edges up to delta are light, about one bucket per average out-degree
+    if (delta == 0) {
+        double degree = graph.edges != 0 ? (double) graph.edges / (double) nodes : 1;
+        delta = max_weight / (degree > 1 ? degree : 1);
+    }
+    if (delta * (double) (_CDS_SSSP_BUCKETS - 2) < max_weight) {
+        delta = max_weight / (double) (_CDS_SSSP_BUCKETS - 2);
+    }
+    if (delta == 0) {
+        delta = 1;
+    }
+
+    // relaxing from bucket k never goes past bucket k + bucket_count - 1
+    bucket_count = (size_t) (max_weight / delta) + 2;
+    buckets = calloc(bucket_count, sizeof(cds_vector));
+    if (buckets == NULL) {
+        goto cleanup;
+    }
+
+    for (size_t i = 0; i < bucket_count; i++) {
+        buckets[i] = cds_vector_create((struct cds_vector_config) {.type = sizeof(unsigned int), .memory = cds_memory_system()});
+        if (buckets[i] == NULL) {
+            goto cleanup;
+        }
+    }
+    for (size_t worker = 0; worker < _cds_pool_size(pool); worker++) {
+        updated[worker] = cds_vector_create((struct cds_vector_config) {.type = sizeof(unsigned int), .memory = cds_memory_system()});
+        if (updated[worker] == NULL) {
+            goto cleanup;
+        }
+    }
+
+    double infinity = INFINITY;
+    for (size_t node = 0; node < nodes; node++) {
+        memcpy(&dist[node], &infinity, sizeof(uint64_t));
+        seen[node] = SIZE_MAX;
+    }
+    dist[source] = 0;
+    cds_vector_pushback(buckets[0], &source);
+
+    struct _cds_sssp_job job = {
+        .graph = &graph,
+        .dist = dist,
+        .source = source,
+        .delta = delta,
+        .updated = updated
+    };
+
+    size_t pass = 0;
+    size_t empty = 0;
+
+    for (size_t bucket = 0; empty < bucket_count; bucket++) {
+        cds_vector current = buckets[bucket % bucket_count];
+        if (cds_vector_size(current) == 0) {
+            empty++;
+            continue;
+        }
+        empty = 0;
+        cds_vector_clear(settled);
+
+        // light edges can refill current bucket, heavy ones run once after
+        while (cds_vector_size(current) != 0) {
+            const unsigned int* entries = cds_vector_data(current);
+            cds_vector_clear(frontier);
+            pass++;
+
+            for (size_t i = 0; i < cds_vector_size(current); i++) {
+                unsigned int node = entries[i];
+                if (seen[node] == pass || _cds_sssp_bucket(dist[node], delta) != bucket) {
+                    continue;
+                }
+
+                if (cds_vector_pushback(frontier, &node) != CDS_OK) {
+                    goto cleanup;
+                }
+                seen[node] = pass;
+            }
+            cds_vector_clear(current);
+
+            if (cds_vector_append_n(settled, cds_vector_data(frontier), cds_vector_size(frontier)) != CDS_OK) {
+                goto cleanup;
+            }
+
+            job.light = true;
+            job.frontier = cds_vector_data(frontier);
+            job.frontier_size = cds_vector_size(frontier);
+            _cds_pool_run(pool, _cds_sssp_relax, &job);
+            if (job.failed) {
+                goto cleanup;
+            }
+
+            for (size_t worker = 0; worker < _cds_pool_size(pool); worker++) {
+                const unsigned int* nodes_updated = cds_vector_data(updated[worker]);
+
+                for (size_t i = 0; i < cds_vector_size(updated[worker]); i++) {
+                    unsigned int node = nodes_updated[i];
+                    cds_vector target = buckets[_cds_sssp_bucket(dist[node], delta) % bucket_count];
+
+                    if (cds_vector_pushback(target, &node) != CDS_OK) {
+                        goto cleanup;
+                    }
+                }
+                cds_vector_clear(updated[worker]);
+            }
+        }
+
+        job.light = false;
+        job.frontier = cds_vector_data(settled);
+        job.frontier_size = cds_vector_size(settled);
+        _cds_pool_run(pool, _cds_sssp_relax, &job);
+        if (job.failed) {
+            goto cleanup;
+        }
+
+        for (size_t worker = 0; worker < _cds_pool_size(pool); worker++) {
+            const unsigned int* nodes_updated = cds_vector_data(updated[worker]);
+
+            for (size_t i = 0; i < cds_vector_size(updated[worker]); i++) {
+                unsigned int node = nodes_updated[i];
+                cds_vector target = buckets[_cds_sssp_bucket(dist[node], delta) % bucket_count];
+
+                if (cds_vector_pushback(target, &node) != CDS_OK) {
+                    goto cleanup;
+                }
+            }
+            cds_vector_clear(updated[worker]);
+        }
+    }
+
+    if (pred_out != NULL) {
+        for (size_t node = 0; node < nodes; node++) {
+            pred_out[node] = CDS_GRAPH_UNREACHED;
+        }
+        pred_out[source] = source;
+
+        // with zero weights tight edges may form cycles, so they are walked
+        // from source, otherwise any tight in-edge is a valid predecessor
+        if (zero_weight) {
+            if (_cds_sssp_tight(&graph, source, dist, pred_out) != CDS_OK) {
+                goto cleanup;
+            }
+        } else {
+            job.pred = pred_out;
+            _cds_pool_run(pool, _cds_sssp_pred, &job);
+        }
+    }
+
+    if (dist_out != NULL) {
+        memcpy(dist_out, dist, sizeof(double) * nodes);
+    }
+    status = CDS_OK;
+
+cleanup:
+    for (size_t i = 0; buckets != NULL && i < bucket_count; i++) {
+        cds_vector_destroy(buckets[i]);
+    }
+    for (size_t worker = 0; updated != NULL && worker < _cds_pool_size(pool); worker++) {
+        cds_vector_destroy(updated[worker]);
+    }
+    free(buckets);
+    free(updated);
+    _cds_pool_destroy(pool);
+    cds_vector_destroy(frontier);
+    cds_vector_destroy(settled);
+    free(seen);
+    free(dist);
+    _cds_graph_view_release(&graph);
+
+    return status;
+}
+
+static int _cds_sssp_check(const struct _cds_graph_view* graph, double* max_weight, bool* zero_weight) {
+    *max_weight = graph->edges != 0 ? 1 : 0;
+    *zero_weight = false;
+
+    if (graph->weights == NULL) {
+        return CDS_OK;
+    }
+
+    *max_weight = 0;
+    for (size_t e = 0; e < graph->edges; e++) {
+        double weight = graph->weights[e];
+
+        // negative weights and NaNs have no shortest paths
+        if (!(weight >= 0) || isinf(weight)) {
+            return CDS_ERR;
+        }
+
+        *max_weight = weight > *max_weight ? weight : *max_weight;
+        *zero_weight |= weight == 0;
+    }
+
+    return CDS_OK;
+}
+
+static int _cds_heap_push(cds_vector heap, double dist, unsigned int node) {
+    if (cds_vector_emplace_back(heap) == NULL) {
+        return CDS_ERR;
+    }
+
+    struct _cds_heap_entry* entries = (struct _cds_heap_entry*) cds_vector_data(heap) + _CDS_HEAP_PAD;
+    size_t pos = cds_vector_size(heap) - _CDS_HEAP_PAD - 1;
+
+    while (pos > 0) {
+        size_t parent = (pos - 1) / _CDS_HEAP_ARITY;
+        if (entries[parent].dist <= dist) {
+            break;
+        }
+
+        entries[pos] = entries[parent];
+        pos = parent;
+    }
+
+    entries[pos] = (struct _cds_heap_entry) {.dist = dist, .node = node};
+    return CDS_OK;
+}
+
+static struct _cds_heap_entry _cds_heap_pop(cds_vector heap) {
+    struct _cds_heap_entry* entries = (struct _cds_heap_entry*) cds_vector_data(heap) + _CDS_HEAP_PAD;
+    size_t size = cds_vector_size(heap) - _CDS_HEAP_PAD - 1;
+
+    struct _cds_heap_entry top = entries[0];
+    struct _cds_heap_entry last = entries[size];
+    size_t pos = 0;
+
+    // sift last entry down from root
+    while (true) {
+        size_t first = pos * _CDS_HEAP_ARITY + 1;
+        if (first >= size) {
+            break;
+        }
+
+        size_t end = first + _CDS_HEAP_ARITY < size ? first + _CDS_HEAP_ARITY : size;
+        size_t best = first;
+        for (size_t child = first + 1; child < end; child++) {
+            if (entries[child].dist < entries[best].dist) {
+                best = child;
+            }
+        }
+
+        if (last.dist <= entries[best].dist) {
+            break;
+        }
+
+        entries[pos] = entries[best];
+        pos = best;
+    }
+
+    entries[pos] = last;
+    cds_vector_popback(heap, NULL);
+
+    return top;
+}
+
+static void _cds_sssp_relax(void* context, size_t index, size_t count) {
+    struct _cds_sssp_job* job = context;
+    const struct _cds_graph_view* graph = job->graph;
+    cds_vector updated = job->updated[index];
+
+    size_t begin, end;
+    _cds_pool_split(job->frontier_size, index, count, &begin, &end);
+
+    for (size_t i = begin; i < end; i++) {
+        unsigned int node = job->frontier[i];
+        uint64_t bits = __atomic_load_n(&job->dist[node], __ATOMIC_RELAXED);
+        double base;
+        memcpy(&base, &bits, sizeof(double));
+
+        for (size_t e = graph->offsets[node]; e < graph->offsets[node + 1]; e++) {
+            double weight = _cds_sssp_weight(graph, e);
+            if ((weight <= job->delta) != job->light) {
+                continue;
+            }
+
+            unsigned int neighbor = graph->targets[e];
+            double candidate = base + weight;
+            uint64_t candidate_bits;
+            memcpy(&candidate_bits, &candidate, sizeof(uint64_t));
+
+            // atomic minimum, retried while candidate is still lower
+            uint64_t current = __atomic_load_n(&job->dist[neighbor], __ATOMIC_RELAXED);
+            while (candidate_bits < current) {
+                if (__atomic_compare_exchange_n(&job->dist[neighbor], &current, candidate_bits, true,
+                    __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                    if (cds_vector_pushback(updated, &neighbor) != CDS_OK) {
+                        __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static void _cds_sssp_pred(void* context, size_t index, size_t count) {
+    struct _cds_sssp_job* job = context;
+    const struct _cds_graph_view* graph = job->graph;
+
+    size_t begin, end;
+    _cds_pool_split(graph->nodes, index, count, &begin, &end);
+
+    for (size_t node = begin; node < end; node++) {
+        double base;
+        memcpy(&base, &job->dist[node], sizeof(double));
+        if (isinf(base)) {
+            continue;
+        }
+
+        for (size_t e = graph->offsets[node]; e < graph->offsets[node + 1]; e++) {
+            unsigned int neighbor = graph->targets[e];
+            double candidate = base + _cds_sssp_weight(graph, e);
+            double dist;
+            memcpy(&dist, &job->dist[neighbor], sizeof(double));
+
+            if (candidate == dist && neighbor != job->source) {
+                __atomic_store_n(&job->pred[neighbor], (unsigned int) node, __ATOMIC_RELAXED);
+            }
+        }
+    }
+}
+
+static int _cds_sssp_tight(const struct _cds_graph_view* graph, unsigned int source, const uint64_t* dist, unsigned int* pred) {
+    unsigned int* queue = malloc(sizeof(unsigned int) * graph->nodes);
+    if (queue == NULL) {
+        return CDS_ERR;
+    }
+
+    size_t head = 0, tail = 0;
+    queue[tail++] = source;
+
+    while (head < tail) {
+        unsigned int node = queue[head++];
+        double base;
+        memcpy(&base, &dist[node], sizeof(double));
+
+        for (size_t e = graph->offsets[node]; e < graph->offsets[node + 1]; e++) {
+            unsigned int neighbor = graph->targets[e];
+            double candidate = base + _cds_sssp_weight(graph, e);
+            double target;
+            memcpy(&target, &dist[neighbor], sizeof(double));
+
+            if (candidate == target && pred[neighbor] == CDS_GRAPH_UNREACHED) {
+                pred[neighbor] = node;
+                queue[tail++] = neighbor;
+            }
+        }
+    }
+
+    free(queue);
+    return CDS_OK;
+}
+
+static size_t _cds_sssp_bucket(uint64_t bits, double delta) {
+    double dist;
+    memcpy(&dist, &bits, sizeof(double));
+
+    return (size_t) (dist / delta);
+}
+
+static double _cds_sssp_weight(const struct _cds_graph_view* graph, size_t edge) {
+    return graph->weights != NULL ? graph->weights[edge] : 1;
+}
@@ -0,0 +1,337 @@
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define _CDS_X86 1
+#endif
+
+#include "graph_internal.h"
+#include "pool.h"
+
+// below it a single thread beats waking the pool
+#define _CDS_TRIANGLES_PARALLEL 16384
+
+/*
+ * Triangles are counted on the undirected simple graph: direction is
+ * ignored, repeated edges and self loops are dropped. Sparse backends get
+ * sorted neighbor arrays intersected by merging, matrix ones a symmetric bit
+ * matrix intersected by AND and popcount.
+ */
+struct _cds_undirected {
+    size_t nodes;
+    size_t edges;
+
+    // sparse backends, neighbors sorted without repeats
+    size_t* offsets;
+    unsigned int* targets;
+
+    // matrix backend, same layout as graph rows
+    uint64_t* bits;
+    size_t words;
+};
+
+struct _cds_triangles_job {
+    const struct _cds_undirected* graph;
+    // triangles found by every worker
+    size_t* found;
+    double* coefficients;
+};
+
+static int _cds_undirected(cds_graph* g, struct _cds_undirected* out);
+static void _cds_undirected_release(struct _cds_undirected* graph);
+static int _cds_triangles_run(cds_graph* g, size_t nthreads, double* coefficients, size_t* count);
+static void _cds_triangles_task(void* context, size_t index, size_t count);
+static void _cds_clustering_task(void* context, size_t index, size_t count);
+static size_t _cds_intersect(const unsigned int* a, size_t a_size, const unsigned int* b, size_t b_size);
+static size_t _cds_intersect_scalar(const unsigned int* a, size_t a_size, const unsigned int* b, size_t b_size);
+static size_t _cds_upper_bound(const unsigned int* row, size_t size, unsigned int value);
+
+size_t cds_graph_triangles(cds_graph* g, size_t nthreads) {
+    size_t count;
+
+    if (g == NULL || _cds_triangles_run(g, nthreads, NULL, &count) != CDS_OK) {
+        return SIZE_MAX;
+    }
+
+    return count;
+}
+
+int cds_graph_clustering(cds_graph* g, double* coefficients_out, size_t nthreads) {
+    if (g == NULL || coefficients_out == NULL) {
+        return CDS_ERR;
+    }
+
+    return _cds_triangles_run(g, nthreads, coefficients_out, NULL);
+}
+
+static int _cds_triangles_run(cds_graph* g, size_t nthreads, double* coefficients, size_t* count) {
+    struct _cds_undirected graph;
+    if (_cds_undirected(g, &graph) != CDS_OK) {
+        return CDS_ERR;
+    }
+
+    size_t threads = graph.edges < _CDS_TRIANGLES_PARALLEL ? 1 : _cds_pool_threads(nthreads);
+    _cds_pool pool = _cds_pool_create(threads);
+    size_t* found = calloc(threads, sizeof(size_t));
+
+    if (pool == NULL || found == NULL) {
+        _cds_pool_destroy(pool);
+        free(found);
+        _cds_undirected_release(&graph);
+        return CDS_ERR;
+    }
+
+    struct _cds_triangles_job job = {.graph = &graph, .found = found, .coefficients = coefficients};
+    _cds_pool_run(pool, coefficients != NULL ? _cds_clustering_task : _cds_triangles_task, &job);
+
+    if (count != NULL) {
+        *count = 0;
+        for (size_t worker = 0; worker < _cds_pool_size(pool); worker++) {
+            *count += found[worker];
+        }
+        // matrix workers see every triangle from each of its edges
+        *count /= graph.bits != NULL ? 3 : 1;
+    }
+
+    _cds_pool_destroy(pool);
+    free(found);
+    _cds_undirected_release(&graph);
+
+    return CDS_OK;
+}
+
+static void _cds_triangles_task(void* context, size_t index, size_t count) {
+    struct _cds_triangles_job* job = context;
+    const struct _cds_undirected* graph = job->graph;
+
+    // nodes are interleaved, low ids have longer forward rows
+    size_t found = 0;
+
+    for (size_t node = index; node < graph->nodes; node += count) {
+        if (graph->bits != NULL) {
+            const uint64_t* row = &graph->bits[node * graph->words];
+
+            for (size_t word = node / 64; word < graph->words; word++) {
+                uint64_t set = row[word];
+                if (word == node / 64) {
+                    set &= ~UINT64_C(0) << (node % 64);
+                }
+
+                for (; set != 0; set &= set - 1) {
+                    size_t neighbor = word * 64 + __builtin_ctzll(set);
+                    found += _cds_bits_and_count(row, &graph->bits[neighbor * graph->words], graph->words);
+                }
+            }
+            continue;
+        }
+
+        // triangle u < v < w is only counted from u, intersecting rows above v
+        const unsigned int* row = &graph->targets[graph->offsets[node]];
+        size_t size = graph->offsets[node + 1] - graph->offsets[node];
+        size_t first = _cds_upper_bound(row, size, (unsigned int) node);
+
+        for (size_t i = first; i < size; i++) {
+            unsigned int neighbor = row[i];
+            const unsigned int* other = &graph->targets[graph->offsets[neighbor]];
+            size_t other_size = graph->offsets[neighbor + 1] - graph->offsets[neighbor];
+            size_t above = _cds_upper_bound(other, other_size, neighbor);
+
+            found += _cds_intersect(&row[i + 1], size - i - 1, &other[above], other_size - above);
+        }
+    }
+
+    job->found[index] = found;
+}
+
+static void _cds_clustering_task(void* context, size_t index, size_t count) {
+    struct _cds_triangles_job* job = context;
+    const struct _cds_undirected* graph = job->graph;
+
+    // workers own their nodes, sums of every neighbor are twice the triangles
+    for (size_t node = index; node < graph->nodes; node += count) {
+        size_t degree, links = 0;
+
+        if (graph->bits != NULL) {
+            const uint64_t* row = &graph->bits[node * graph->words];
+
+            degree = _cds_bits_count(row, graph->words);
+            for (size_t word = 0; word < graph->words; word++) {
+                for (uint64_t set = row[word]; set != 0; set &= set - 1) {
+                    size_t neighbor = word * 64 + __builtin_ctzll(set);
+                    links += _cds_bits_and_count(row, &graph->bits[neighbor * graph->words], graph->words);
+                }
+            }
+        } else {
+            const unsigned int* row = &graph->targets[graph->offsets[node]];
+
+            degree = graph->offsets[node + 1] - graph->offsets[node];
+            for (size_t i = 0; i < degree; i++) {
+                size_t begin = graph->offsets[row[i]];
+                links += _cds_intersect(row, degree, &graph->targets[begin], graph->offsets[row[i] + 1] - begin);
+            }
+        }
+
+        job->coefficients[node] = degree < 2 ? 0 : (double) links / ((double) degree * (double) (degree - 1));
+    }
+}
+
+static int _cds_undirected(cds_graph* g, struct _cds_undirected* out) {
+    *out = (struct _cds_undirected) {.nodes = (size_t) g->nodes};
+
+    if (g->kind == CDS_GRAPH_MATRIX) {
+        size_t words = g->words * out->nodes;
+
+        out->words = g->words;
+        out->bits = aligned_alloc(_CDS_MATRIX_ALIGN, sizeof(uint64_t) * (words != 0 ? words : _CDS_MATRIX_LINE));
+        if (out->bits == NULL) {
+            return CDS_ERR;
+        }
+
+        // every edge is mirrored, the diagonal is cleared afterwards
+        memcpy(out->bits, g->bits, sizeof(uint64_t) * words);
+        for (size_t node = 0; node < out->nodes; node++) {
+            const uint64_t* row = _CDS_MATRIX_ROW(g, node);
+
+            for (size_t word = 0; word < g->words; word++) {
+                for (uint64_t set = row[word]; set != 0; set &= set - 1) {
+                    size_t neighbor = word * 64 + __builtin_ctzll(set);
+                    out->bits[neighbor * out->words + node / 64] |= UINT64_C(1) << (node % 64);
+                }
+            }
+        }
+        for (size_t node = 0; node < out->nodes; node++) {
+            out->bits[node * out->words + node / 64] &= ~(UINT64_C(1) << (node % 64));
+            out->edges += _cds_bits_count(&out->bits[node * out->words], out->words);
+        }
+
+        return CDS_OK;
+    }
+
+    struct _cds_graph_view graph, reverse = {0};
+    if (_cds_graph_view(g, &graph, false) != CDS_OK) {
+        return CDS_ERR;
+    }
+    // list rows come in insertion order
+    _cds_graph_view_sort(&graph);
+
+    out->offsets = malloc(sizeof(size_t) * (out->nodes + 1));
+    out->targets = malloc(sizeof(unsigned int) * (graph.edges * 2 + 1));
+
+    if (out->offsets == NULL || out->targets == NULL || _cds_graph_view_transpose(&graph, &reverse) != CDS_OK) {
+        _cds_graph_view_release(&graph);
+        _cds_undirected_release(out);
+        return CDS_ERR;
+    }
+
+    // out and in rows are both sorted, a merge gives their union
+    size_t written = 0;
+    for (size_t node = 0; node < out->nodes; node++) {
+        size_t i = graph.offsets[node], i_end = graph.offsets[node + 1];
+        size_t j = reverse.offsets[node], j_end = reverse.offsets[node + 1];
+
+        out->offsets[node] = written;
+        while (i < i_end || j < j_end) {
+            unsigned int next;
+
+            if (j == j_end || (i < i_end && graph.targets[i] < reverse.targets[j])) {
+                next = graph.targets[i++];
+            } else if (i == i_end || reverse.targets[j] < graph.targets[i]) {
+                next = reverse.targets[j++];
+            } else {
+                next = graph.targets[i++];
+                j++;
+            }
+
+            if (next != node) {
+                out->targets[written++] = next;
+            }
+        }
+    }
+    out->offsets[out->nodes] = written;
+    out->edges = written;
+
+    _cds_graph_view_release(&reverse);
+    _cds_graph_view_release(&graph);
+
+    return CDS_OK;
+}
+
+static void _cds_undirected_release(struct _cds_undirected* graph) {
+    free(graph->offsets);
+    free(graph->targets);
+    free(graph->bits);
+}
+
+#ifdef _CDS_X86
+/*
+ * Block merge of two sorted arrays without repeats: 8 values of a are
+ * compared against all 8 rotations of a block of b, then the block with
+ * lower last value moves on.
+ */
+__attribute__((target("avx2")))
+static size_t _cds_intersect_avx2(const unsigned int* a, size_t a_size, const unsigned int* b, size_t b_size) {
+    const __m256i rotate = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+    size_t i = 0, j = 0, count = 0;
+
+    while (i + 8 <= a_size && j + 8 <= b_size) {
+        __m256i va = _mm256_loadu_si256((const __m256i*) &a[i]);
+        __m256i vb = _mm256_loadu_si256((const __m256i*) &b[j]);
+        __m256i equal = _mm256_cmpeq_epi32(va, vb);
+
+        for (int r = 1; r < 8; r++) {
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            equal = _mm256_or_si256(equal, _mm256_cmpeq_epi32(va, vb));
+        }
+        count += (size_t) __builtin_popcount((unsigned int) _mm256_movemask_ps(_mm256_castsi256_ps(equal)));
+
+        unsigned int a_last = a[i + 7], b_last = b[j + 7];
+        i += a_last <= b_last ? 8 : 0;
+        j += b_last <= a_last ? 8 : 0;
+    }
+
+    return count + _cds_intersect_scalar(&a[i], a_size - i, &b[j], b_size - j);
+}
+#endif
+
+static size_t _cds_intersect(const unsigned int* a, size_t a_size, const unsigned int* b, size_t b_size) {
+#ifdef _CDS_X86
+    if (a_size >= 8 && b_size >= 8 && __builtin_cpu_supports("avx2")) {
+        return _cds_intersect_avx2(a, a_size, b, b_size);
+    }
+#endif
+
+    return _cds_intersect_scalar(a, a_size, b, b_size);
+}
+
+static size_t _cds_intersect_scalar(const unsigned int* a, size_t a_size, const unsigned int* b, size_t b_size) {
+    size_t i = 0, j = 0, count = 0;
+
+    // branchless, which side moves is not predictable
+    while (i < a_size && j < b_size) {
+        unsigned int x = a[i], y = b[j];
+
+        count += x == y;
+        i += x <= y;
+        j += y <= x;
+    }
+
+    return count;
+}
+
+// first position in row with a value above given one
+static size_t _cds_upper_bound(const unsigned int* row, size_t size, unsigned int value) {
+    size_t low = 0, high = size;
+
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+
+        if (row[middle] <= value) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
@@ -0,0 +1,231 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/cds.h>
+
+#include "graph_internal.h"
+
+// target comes first, so pairs sort with the same comparison as targets
+struct _cds_view_edge {
+    unsigned int target;
+    double weight;
+};
+
+static int _cds_view_alloc(struct _cds_graph_view* view, size_t nodes, size_t edges);
+static int _cds_view_list(cds_graph* g, struct _cds_graph_view* view, bool weights);
+static int _cds_view_target_cmp(const void* a, const void* b);
+
+int _cds_graph_view(cds_graph* g, struct _cds_graph_view* view, bool weights) {
+    size_t nodes = (size_t) g->nodes;
+
+    if (g->kind == CDS_GRAPH_CSR) {
+        *view = (struct _cds_graph_view) {
+            .nodes = nodes,
+            .edges = g->offsets[nodes],
+            .offsets = g->offsets,
+            .targets = g->targets,
+            .sorted = true
+        };
+        return CDS_OK;
+    }
+
+    if (g->kind == CDS_GRAPH_LIST) {
+        return _cds_view_list(g, view, weights);
+    }
+
+    // matrix rows are counted first, then set bits are listed in order
+    size_t edges = 0;
+    for (size_t node = 0; node < nodes; node++) {
+        edges += _cds_bits_count(_CDS_MATRIX_ROW(g, node), g->words);
+    }
+
+    if (_cds_view_alloc(view, nodes, edges) != CDS_OK) {
+        return CDS_ERR;
+    }
+
+    size_t written = 0;
+    for (size_t node = 0; node < nodes; node++) {
+        const uint64_t* row = _CDS_MATRIX_ROW(g, node);
+
+        view->owned_offsets[node] = written;
+        for (size_t word = 0; word < g->words; word++) {
+            for (uint64_t bits = row[word]; bits != 0; bits &= bits - 1) {
+                view->owned_targets[written++] = (unsigned int) (word * 64 + __builtin_ctzll(bits));
+            }
+        }
+    }
+    view->owned_offsets[nodes] = written;
+    view->sorted = true;
+
+    return CDS_OK;
+}
+
+int _cds_graph_view_transpose(const struct _cds_graph_view* view, struct _cds_graph_view* out) {
+    if (_cds_view_alloc(out, view->nodes, view->edges) != CDS_OK) {
+        return CDS_ERR;
+    }
+
+    size_t* offsets = out->owned_offsets;
+    memset(offsets, 0, sizeof(size_t) * (view->nodes + 1));
+
+    for (size_t i = 0; i < view->edges; i++) {
+        offsets[view->targets[i] + 1]++;
+    }
+    for (size_t node = 0; node < view->nodes; node++) {
+        offsets[node + 1] += offsets[node];
+    }
+
+    // sources are visited in order, so every reversed row ends up sorted
+    for (size_t node = 0; node < view->nodes; node++) {
+        for (size_t i = view->offsets[node]; i < view->offsets[node + 1]; i++) {
+            out->owned_targets[offsets[view->targets[i]]++] = (unsigned int) node;
+        }
+    }
+    for (size_t node = view->nodes; node > 0; node--) {
+        offsets[node] = offsets[node - 1];
+    }
+    offsets[0] = 0;
+    out->sorted = true;
+
+    return CDS_OK;
+}
+
+int _cds_graph_view_sort(struct _cds_graph_view* view) {
+    if (view->sorted) {
+        return CDS_OK;
+    }
+
+    if (view->owned_weights == NULL) {
+        for (size_t node = 0; node < view->nodes; node++) {
+            size_t begin = view->offsets[node];
+            qsort(&view->owned_targets[begin], view->offsets[node + 1] - begin, sizeof(unsigned int), _cds_view_target_cmp);
+        }
+        view->sorted = true;
+        return CDS_OK;
+    }
+
+    // weights move with their targets, rows are sorted as pairs
+    size_t longest = 0;
+    for (size_t node = 0; node < view->nodes; node++) {
+        size_t degree = view->offsets[node + 1] - view->offsets[node];
+        longest = degree > longest ? degree : longest;
+    }
+
+    struct _cds_view_edge* pairs = malloc(sizeof(struct _cds_view_edge) * (longest + 1));
+    if (pairs == NULL) {
+        return CDS_ERR;
+    }
+
+    for (size_t node = 0; node < view->nodes; node++) {
+        size_t begin = view->offsets[node];
+        size_t degree = view->offsets[node + 1] - begin;
+
+        for (size_t i = 0; i < degree; i++) {
+            pairs[i] = (struct _cds_view_edge) {view->owned_targets[begin + i], view->owned_weights[begin + i]};
+        }
+        qsort(pairs, degree, sizeof(struct _cds_view_edge), _cds_view_target_cmp);
+        for (size_t i = 0; i < degree; i++) {
+            view->owned_targets[begin + i] = pairs[i].target;
+            view->owned_weights[begin + i] = pairs[i].weight;
+        }
+    }
+
+    free(pairs);
+    view->sorted = true;
+
+    return CDS_OK;
+}
+
+size_t _cds_graph_view_row(const struct _cds_graph_view* view, size_t edge) {
+    size_t low = 0, high = view->nodes;
+
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+
+        if (view->offsets[middle + 1] <= edge) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+void _cds_graph_view_release(struct _cds_graph_view* view) {
+    free(view->owned_offsets);
+    free(view->owned_targets);
+    free(view->owned_weights);
+
+    *view = (struct _cds_graph_view) {0};
+}
+
+static int _cds_view_alloc(struct _cds_graph_view* view, size_t nodes, size_t edges) {
+    *view = (struct _cds_graph_view) {.nodes = nodes, .edges = edges};
+
+    view->owned_offsets = malloc(sizeof(size_t) * (nodes + 1));
+    view->owned_targets = malloc(sizeof(unsigned int) * (edges != 0 ? edges : 1));
+
+    if (view->owned_offsets == NULL || view->owned_targets == NULL) {
+        _cds_graph_view_release(view);
+        return CDS_ERR;
+    }
+
+    view->offsets = view->owned_offsets;
+    view->targets = view->owned_targets;
+
+    return CDS_OK;
+}
+
+static int _cds_view_list(cds_graph* g, struct _cds_graph_view* view, bool weights) {
+    struct _cds_list_row* rows = cds_vector_data(g->rows);
+    size_t nodes = (size_t) g->nodes;
+
+    size_t edges = 0;
+    bool weighted = false;
+    for (size_t node = 0; node < nodes; node++) {
+        edges += cds_vector_size(rows[node].targets);
+        weighted |= rows[node].weights != NULL;
+    }
+
+    if (_cds_view_alloc(view, nodes, edges) != CDS_OK) {
+        return CDS_ERR;
+    }
+
+    if (weights && weighted) {
+        view->owned_weights = malloc(sizeof(double) * (edges != 0 ? edges : 1));
+        if (view->owned_weights == NULL) {
+            _cds_graph_view_release(view);
+            return CDS_ERR;
+        }
+        view->weights = view->owned_weights;
+    }
+
+    size_t written = 0;
+    for (size_t node = 0; node < nodes; node++) {
+        size_t degree = cds_vector_size(rows[node].targets);
+
+        view->owned_offsets[node] = written;
+        if (degree != 0) {
+            memcpy(&view->owned_targets[written], cds_vector_data(rows[node].targets), sizeof(unsigned int) * degree);
+        }
+
+        if (view->owned_weights != NULL) {
+            const double* row = cds_vector_data(rows[node].weights);
+            for (size_t i = 0; i < degree; i++) {
+                view->owned_weights[written + i] = row != NULL ? row[i] : 1;
+            }
+        }
+        written += degree;
+    }
+    view->owned_offsets[nodes] = written;
+
+    return CDS_OK;
+}
+
+static int _cds_view_target_cmp(const void* a, const void* b) {
+    unsigned int x = *(const unsigned int*) a;
+    unsigned int y = *(const unsigned int*) b;
+
+    return (x > y) - (x < y);
+}
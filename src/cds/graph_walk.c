@@ -0,0 +1,295 @@
+#include <stdlib.h>
+
+#include <cds/vector.h>
+
+#include "graph_internal.h"
+#include "pool.h"
+
+// below it a single thread beats waking the pool
+#define _CDS_WALK_PARALLEL 65536
+
+/*
+ * Weighted rows are sampled in O(1) with Walker's alias method: step picks
+ * an edge uniformly, keeps it with probability chance[e] and otherwise takes
+ * alias[e] instead, both tables are laid out like targets.
+ */
+struct _cds_alias {
+    double* chance;
+    unsigned int* alias;
+};
+
+struct _cds_walk_job {
+    const struct _cds_graph_view* graph;
+    const struct _cds_alias* alias;
+    struct cds_graph_walk_config config;
+
+    unsigned int* walks;
+    size_t count;
+
+    // node2vec factors for going back, to a neighbor of previous node and
+    // further away, all divided by the largest one
+    double back;
+    double near;
+    double far;
+};
+
+// splitmix64, a walk's generator only depends on seed and walk index
+struct _cds_random {
+    uint64_t state;
+};
+
+static void _cds_walk_task(void* context, size_t index, size_t count);
+static size_t _cds_walk_step(const struct _cds_walk_job* job, struct _cds_random* random, unsigned int node);
+static bool _cds_walk_linked(const struct _cds_graph_view* graph, unsigned int from, unsigned int to);
+static int _cds_alias_build(const struct _cds_graph_view* graph, struct _cds_alias* alias);
+static void _cds_alias_release(struct _cds_alias* alias);
+static uint64_t _cds_random_next(struct _cds_random* random);
+static size_t _cds_random_below(struct _cds_random* random, size_t bound);
+static double _cds_random_unit(struct _cds_random* random);
+
+int cds_graph_random_walks(cds_graph* g, struct cds_graph_walk_config config, CDS_VECTOR(unsigned int) walks_out) {
+    if (g == NULL || walks_out == NULL || walks_out->type != sizeof(unsigned int) || config.length == 0
+        || config.kind > CDS_GRAPH_WALK_NODE2VEC
+        || (config.kind == CDS_GRAPH_WALK_NODE2VEC && !(config.p > 0 && config.q > 0))) {
+        return CDS_ERR;
+    }
+
+    size_t nodes = (size_t) g->nodes;
+    size_t count = nodes * config.walks_per_node;
+    if ((config.walks_per_node != 0 && count / config.walks_per_node != nodes) || count > SIZE_MAX / config.length) {
+        return CDS_ERR;
+    }
+
+    struct _cds_graph_view graph;
+    struct _cds_alias alias = {0};
+    bool weighted = config.kind != CDS_GRAPH_WALK_UNIFORM;
+
+    if (_cds_graph_view(g, &graph, weighted) != CDS_OK) {
+        return CDS_ERR;
+    }
+
+    int status = CDS_ERR;
+
+    // node2vec looks previous node up in sorted rows, alias tables follow them
+    if ((config.kind == CDS_GRAPH_WALK_NODE2VEC && _cds_graph_view_sort(&graph) != CDS_OK)
+        || (weighted && graph.weights != NULL && _cds_alias_build(&graph, &alias) != CDS_OK)) {
+        goto cleanup;
+    }
+
+    // a single resize, vectors reserved beforehand are not reallocated
+    if (cds_vector_resize(walks_out, count * config.length, NULL) != CDS_OK) {
+        goto cleanup;
+    }
+
+    struct _cds_walk_job job = {
+        .graph = &graph,
+        .alias = graph.weights != NULL ? &alias : NULL,
+        .config = config,
+        .walks = cds_vector_data(walks_out),
+        .count = count
+    };
+
+    if (config.kind == CDS_GRAPH_WALK_NODE2VEC) {
+        double back = 1 / config.p, far = 1 / config.q;
+        double largest = back > 1 ? back : 1;
+        largest = far > largest ? far : largest;
+
+        job.back = back / largest;
+        job.near = 1 / largest;
+        job.far = far / largest;
+    }
+
+    size_t threads = count * config.length < _CDS_WALK_PARALLEL ? 1 : _cds_pool_threads(config.nthreads);
+    _cds_pool pool = _cds_pool_create(threads);
+    if (pool == NULL) {
+        goto cleanup;
+    }
+
+    _cds_pool_run(pool, _cds_walk_task, &job);
+    _cds_pool_destroy(pool);
+
+    status = CDS_OK;
+
+cleanup:
+    _cds_alias_release(&alias);
+    _cds_graph_view_release(&graph);
+
+    return status;
+}
+
+static void _cds_walk_task(void* context, size_t index, size_t count) {
+    const struct _cds_walk_job* job = context;
+    const struct _cds_graph_view* graph = job->graph;
+    size_t length = job->config.length;
+
+    size_t begin, end;
+    _cds_pool_split(job->count, index, count, &begin, &end);
+
+    for (size_t walk = begin; walk < end; walk++) {
+        // walks go round by round over every node
+        unsigned int* out = &job->walks[walk * length];
+        struct _cds_random random = {job->config.seed ^ (walk * UINT64_C(0xd1b54a32d192ed03))};
+
+        _cds_random_next(&random);
+        out[0] = (unsigned int) (walk % graph->nodes);
+
+        size_t step = 1;
+        for (; step < length; step++) {
+            unsigned int node = out[step - 1];
+            size_t degree = graph->offsets[node + 1] - graph->offsets[node];
+
+            if (degree == 0) {
+                break;
+            }
+
+            if (job->config.kind != CDS_GRAPH_WALK_NODE2VEC || step == 1) {
+                out[step] = graph->targets[_cds_walk_step(job, &random, node)];
+                continue;
+            }
+
+            // rejection sampling: first-order candidates kept in proportion
+            // to their return or in-out factor, nothing is precomputed per edge
+            unsigned int previous = out[step - 2];
+            for (;;) {
+                unsigned int candidate = graph->targets[_cds_walk_step(job, &random, node)];
+                double accept = candidate == previous ? job->back
+                    : _cds_walk_linked(graph, previous, candidate) ? job->near : job->far;
+
+                if (accept >= 1 || _cds_random_unit(&random) < accept) {
+                    out[step] = candidate;
+                    break;
+                }
+            }
+        }
+
+        // walks stuck on a node without out-edges are padded
+        for (; step < length; step++) {
+            out[step] = CDS_GRAPH_UNREACHED;
+        }
+    }
+}
+
+// first-order step, an edge of node by weight or uniformly
+static size_t _cds_walk_step(const struct _cds_walk_job* job, struct _cds_random* random, unsigned int node) {
+    size_t begin = job->graph->offsets[node];
+    size_t edge = begin + _cds_random_below(random, job->graph->offsets[node + 1] - begin);
+
+    if (job->alias == NULL || _cds_random_unit(random) < job->alias->chance[edge]) {
+        return edge;
+    }
+
+    return begin + job->alias->alias[edge];
+}
+
+static bool _cds_walk_linked(const struct _cds_graph_view* graph, unsigned int from, unsigned int to) {
+    size_t low = graph->offsets[from];
+    size_t high = graph->offsets[from + 1];
+
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+
+        if (graph->targets[middle] < to) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low < graph->offsets[from + 1] && graph->targets[low] == to;
+}
+
+static int _cds_alias_build(const struct _cds_graph_view* graph, struct _cds_alias* alias) {
+    size_t longest = 0;
+    for (size_t node = 0; node < graph->nodes; node++) {
+        size_t degree = graph->offsets[node + 1] - graph->offsets[node];
+        longest = degree > longest ? degree : longest;
+    }
+
+    alias->chance = malloc(sizeof(double) * (graph->edges + 1));
+    alias->alias = malloc(sizeof(unsigned int) * (graph->edges + 1));
+    // row positions of edges under and over average weight
+    unsigned int* small = malloc(sizeof(unsigned int) * (longest * 2 + 1));
+    unsigned int* large = &small[longest];
+
+    if (alias->chance == NULL || alias->alias == NULL || small == NULL) {
+        free(small);
+        _cds_alias_release(alias);
+        return CDS_ERR;
+    }
+
+    for (size_t node = 0; node < graph->nodes; node++) {
+        size_t begin = graph->offsets[node];
+        size_t degree = graph->offsets[node + 1] - begin;
+        double* chance = &alias->chance[begin];
+        unsigned int* other = &alias->alias[begin];
+
+        double total = 0;
+        for (size_t i = 0; i < degree; i++) {
+            total += graph->weights[begin + i] > 0 ? graph->weights[begin + i] : 0;
+        }
+
+        size_t smalls = 0, larges = 0;
+        for (size_t i = 0; i < degree; i++) {
+            double weight = graph->weights[begin + i] > 0 ? graph->weights[begin + i] : 0;
+
+            // rows without positive weight are walked uniformly
+            chance[i] = total > 0 ? weight * (double) degree / total : 1;
+            other[i] = (unsigned int) i;
+
+            if (chance[i] < 1) {
+                small[smalls++] = (unsigned int) i;
+            } else {
+                large[larges++] = (unsigned int) i;
+            }
+        }
+
+        // Vose: every small slot is topped up by a large one
+        while (smalls != 0 && larges != 0) {
+            unsigned int low = small[--smalls];
+            unsigned int high = large[larges - 1];
+
+            other[low] = high;
+            chance[high] -= 1 - chance[low];
+
+            if (chance[high] < 1) {
+                larges--;
+                small[smalls++] = high;
+            }
+        }
+
+        // what is left is 1 up to rounding
+        while (larges != 0) {
+            chance[large[--larges]] = 1;
+        }
+        while (smalls != 0) {
+            chance[small[--smalls]] = 1;
+        }
+    }
+
+    free(small);
+    return CDS_OK;
+}
+
+static void _cds_alias_release(struct _cds_alias* alias) {
+    free(alias->chance);
+    free(alias->alias);
+
+    *alias = (struct _cds_alias) {0};
+}
+
+static uint64_t _cds_random_next(struct _cds_random* random) {
+    uint64_t z = (random->state += UINT64_C(0x9e3779b97f4a7c15));
+
+    z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+    return z ^ (z >> 31);
+}
+
+// multiply and shift instead of modulo, bias is below 2^-32 for node degrees
+static size_t _cds_random_below(struct _cds_random* random, size_t bound) {
+    return (size_t) (((unsigned __int128) _cds_random_next(random) * bound) >> 64);
+}
+
+static double _cds_random_unit(struct _cds_random* random) {
+    return (double) (_cds_random_next(random) >> 11) * 0x1.0p-53;
+}
@@ -2,58 +2,42 @@
 
 #include <cds/iter.h>
 
-struct cds_iter_i {
-    struct cds_memory memory;
-    void* structure;
-    void* data;
-
-    bool (*has_next)(void* structure, void** data);
-    void* (*next)(void* structure, void** data);
-
-    bool (*has_back)(void* structure, void** data);
-    void* (*back)(void* structure, void** data);
-    
-    bool (*is_similar)(void* data, void* other);
-    size_t (*distance)(void* data, void* other);
-
-    bool (*is_valid)(void* structure, void* data);
-    void (*destroy)(void* structure, void* data);
-};
-
 CDS_ITER(T) cds_iter_create(void* structure, struct cds_iter_config config) {
-    if (structure == NULL || !cds_memory_valid(config.memory)) {
+    if (structure == NULL || config.vtable == NULL || !cds_memory_valid(config.memory)) {
         return NULL;
     }
 
-    CDS_ITER(T) iter = config.memory.allocator(sizeof(struct cds_iter_i));
+    CDS_ITER(T) iter = config.memory.allocator(config.memory.context, sizeof(struct cds_iter_i));
     
     if (iter != NULL) {
-        iter->memory = config.memory;
-        iter->structure = structure;
-        iter->data = config.initial_data;
+        cds_iter_init(iter, structure, config.vtable, config.initial_data);
 
-        iter->has_next = config.has_next;
-        iter->next = config.next;
-
-        iter->has_back = config.has_back;
-        iter->back = config.back;
+        iter->memory = config.memory;
+        iter->owned = true;
+    }
 
-        iter->is_similar = config.is_similar;
-        iter->distance = config.distance;
+    return iter;
+}
 
-        iter->is_valid = config.is_valid;
-        iter->destroy = config.destroy;
+void cds_iter_init(CDS_ITER(T) iter, void* structure, const struct cds_iter_vtable* vtable, void* data) {
+    if (iter == NULL) {
+        return;
     }
 
-    return iter;
+    iter->vtable = vtable;
+    iter->structure = structure;
+    iter->data = data;
+
+    iter->memory = (struct cds_memory) {0};
+    iter->owned = false;
 }
 
 bool cds_iter_valid(CDS_ITER(T) iter) {
-    if (iter == NULL | iter->is_valid == NULL) {
+    if (iter == NULL || iter->vtable->is_valid == NULL) {
         return false;
     }
 
-    return iter->is_valid(iter->structure, iter->data);
+    return iter->vtable->is_valid(iter->structure, iter->data);
 }
 
 void cds_iter_destroy(CDS_ITER(T) iter) {
@@ -61,58 +45,74 @@ void cds_iter_destroy(CDS_ITER(T) iter) {
         return;
     }
 
-    if (iter->destroy != NULL) {
-        iter->destroy(iter->structure, iter->data);
+    if (iter->vtable->destroy != NULL) {
+        iter->vtable->destroy(iter->structure, iter->data);
     }
 
-    iter->memory.deallocator(iter);
+    if (iter->owned) {
+        iter->memory.deallocator(iter->memory.context, iter);
+    }
 }
 
 bool cds_iter_similar(CDS_ITER(T) first, CDS_ITER(T) second) {
-    if (first == NULL || first->is_similar == NULL || second == NULL) {
+    if (first == NULL || first->vtable->is_similar == NULL || second == NULL) {
         return false;
     }
 
-    return first->is_similar(first->data, second->data) ? true : false;
+    return first->vtable->is_similar(first->data, second->data) ? true : false;
 }
 
 size_t cds_iter_distance(CDS_ITER(T) first, CDS_ITER(T) second) {
-    if (first == NULL || first->distance == NULL || second == NULL) {
+    if (first == NULL || first->vtable->distance == NULL || second == NULL) {
         return 0;
     }
 
-    return first->distance(first->data, second->data);
+    return first->vtable->distance(first->data, second->data);
 }
 
 bool cds_iter_hasnext(CDS_ITER(T) iter) {
-    if (iter == NULL || iter->has_next == NULL) {
+    if (iter == NULL || iter->vtable->has_next == NULL) {
         return false;
     }
 
-    return iter->has_next(iter->structure, &iter->data) ? true : false;
+    return iter->vtable->has_next(iter->structure, &iter->data) ? true : false;
 }
 
 CDS_OBJ(T) cds_iter_next(CDS_ITER(T) iter) {
-    if (iter == NULL || iter->next == NULL) {
+    if (iter == NULL || iter->vtable->next == NULL) {
         return NULL;
     }
 
-    return iter->next(iter->structure, &iter->data);
+    return iter->vtable->next(iter->structure, &iter->data);
+}
+
+size_t cds_iter_next_batch(CDS_ITER(T) iter, CDS_OBJ(T)* out, size_t max) {
+    if (iter == NULL || out == NULL || max == 0) {
+        return 0;
+    }
+
+    if (iter->vtable->next_batch != NULL) {
+        return iter->vtable->next_batch(iter->structure, &iter->data, out, max);
+    }
+
+    // nothing is known about layout, a single element is a run
+    *out = cds_iter_next(iter);
+    return *out != NULL ? 1 : 0;
 }
 
 bool cds_iter_hasback(CDS_ITER(T) iter) {
-    if (iter == NULL || iter->has_back == NULL) {
+    if (iter == NULL || iter->vtable->has_back == NULL) {
         return false;
     }
 
-    return iter->has_back(iter->structure, &iter->data);
+    return iter->vtable->has_back(iter->structure, &iter->data);
 }
 
 CDS_OBJ(T) cds_iter_back(CDS_ITER(T) iter) {
-    if (iter == NULL || iter->back == NULL) {
+    if (iter == NULL || iter->vtable->back == NULL) {
         return NULL;
     }
 
-    return iter->back(iter->structure, &iter->data);
+    return iter->vtable->back(iter->structure, &iter->data);
 }
 
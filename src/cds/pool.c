@@ -0,0 +1,175 @@
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <threads.h>
+#include <unistd.h>
+
+#include "pool.h"
+
+struct _cds_pool_i {
+    size_t threads;
+    thrd_t* workers;
+
+    mtx_t lock;
+    cnd_t wake;
+    cnd_t done;
+
+    size_t generation;
+    size_t pending;
+    bool stop;
+
+    _cds_task task;
+    void* context;
+};
+
+struct _cds_pool_worker {
+    _cds_pool pool;
+    size_t index;
+};
+
+static int _cds_pool_work(void* data);
+
+size_t _cds_pool_threads(size_t requested) {
+    if (requested != 0) {
+        return requested;
+    }
+
+#ifdef _SC_NPROCESSORS_ONLN
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    if (online > 0) {
+        return (size_t) online;
+    }
+#endif
+
+    return 1;
+}
+
+_cds_pool _cds_pool_create(size_t threads) {
+    _cds_pool pool = malloc(sizeof(struct _cds_pool_i));
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    pool->threads = 1;
+    pool->workers = NULL;
+    pool->generation = 0;
+    pool->pending = 0;
+    pool->stop = false;
+
+    if (threads <= 1) {
+        return pool;
+    }
+
+    pool->workers = malloc(sizeof(thrd_t) * (threads - 1));
+    if (pool->workers == NULL) {
+        return pool;
+    }
+
+    mtx_init(&pool->lock, mtx_plain);
+    cnd_init(&pool->wake);
+    cnd_init(&pool->done);
+
+    for (size_t i = 1; i < threads; i++) {
+        struct _cds_pool_worker* worker = malloc(sizeof(struct _cds_pool_worker));
+        if (worker == NULL) {
+            break;
+        }
+
+        worker->pool = pool;
+        worker->index = i;
+
+        if (thrd_create(&pool->workers[i - 1], _cds_pool_work, worker) != thrd_success) {
+            free(worker);
+            break;
+        }
+
+        pool->threads++;
+    }
+
+    return pool;
+}
+
+void _cds_pool_destroy(_cds_pool pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    if (pool->workers != NULL) {
+        mtx_lock(&pool->lock);
+        pool->stop = true;
+        cnd_broadcast(&pool->wake);
+        mtx_unlock(&pool->lock);
+
+        for (size_t i = 1; i < pool->threads; i++) {
+            thrd_join(pool->workers[i - 1], NULL);
+        }
+
+        cnd_destroy(&pool->done);
+        cnd_destroy(&pool->wake);
+        mtx_destroy(&pool->lock);
+        free(pool->workers);
+    }
+
+    free(pool);
+}
+
+size_t _cds_pool_size(_cds_pool pool) {
+    return pool != NULL ? pool->threads : 1;
+}
+
+void _cds_pool_run(_cds_pool pool, _cds_task task, void* context) {
+    if (pool == NULL || pool->threads == 1) {
+        task(context, 0, 1);
+        return;
+    }
+
+    mtx_lock(&pool->lock);
+    pool->task = task;
+    pool->context = context;
+    pool->pending = pool->threads - 1;
+    pool->generation++;
+    cnd_broadcast(&pool->wake);
+    mtx_unlock(&pool->lock);
+
+    task(context, 0, pool->threads);
+
+    mtx_lock(&pool->lock);
+    while (pool->pending != 0) {
+        cnd_wait(&pool->done, &pool->lock);
+    }
+    mtx_unlock(&pool->lock);
+}
+
+static int _cds_pool_work(void* data) {
+    struct _cds_pool_worker* worker = data;
+    _cds_pool pool = worker->pool;
+    size_t index = worker->index;
+    size_t seen = 0;
+
+    free(worker);
+
+    while (true) {
+        mtx_lock(&pool->lock);
+        while (pool->generation == seen && !pool->stop) {
+            cnd_wait(&pool->wake, &pool->lock);
+        }
+
+        if (pool->stop) {
+            mtx_unlock(&pool->lock);
+            return 0;
+        }
+
+        seen = pool->generation;
+        _cds_task task = pool->task;
+        void* context = pool->context;
+        mtx_unlock(&pool->lock);
+
+        task(context, index, pool->threads);
+
+        mtx_lock(&pool->lock);
+        if (--pool->pending == 0) {
+            cnd_signal(&pool->done);
+        }
+        mtx_unlock(&pool->lock);
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef CDS_POOL_GUARD_HEADER
+#define CDS_POOL_GUARD_HEADER
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * Internal thread pool, not part of the public API.
+ *
+ * Workers are created once and reused for every run, the caller's thread
+ * takes part as worker 0.
+ */
+
+typedef struct _cds_pool_i* _cds_pool;
+
+// work for a worker, index in range [0, count)
+typedef void (*_cds_task)(void* context, size_t index, size_t count);
+
+/**
+ * Resolve how many threads to use, 0 means one per online CPU.
+ */
+size_t _cds_pool_threads(size_t requested);
+
+/**
+ * Create a pool with given threads, caller included.
+ *
+ * If threads can not be spawned pool runs with fewer of them, NULL is only
+ * returned without memory.
+ */
+_cds_pool _cds_pool_create(size_t threads);
+void _cds_pool_destroy(_cds_pool pool);
+
+/**
+ * Check how many workers take part in each run.
+ */
+size_t _cds_pool_size(_cds_pool pool);
+
+/**
+ * Run task in every worker and wait for all of them.
+ */
+void _cds_pool_run(_cds_pool pool, _cds_task task, void* context);
+
+/**
+ * Split range [0, size) in count parts and give back part index.
+ */
+static inline void _cds_pool_split(size_t size, size_t index, size_t count, size_t* begin, size_t* end) {
+    size_t part = size / count;
+    size_t rest = size % count;
+
+    *begin = index * part + (index < rest ? index : rest);
+    *end = *begin + part + (index < rest ? 1 : 0);
+}
+
+#endif // CDS_POOL_GUARD_HEADER
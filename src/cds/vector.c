@@ -1,17 +1,48 @@
+#define _GNU_SOURCE
+
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define _CDS_MMAP 1
+#endif
+
+#if defined(__linux__)
+#define _CDS_HUGE_PAGES 1
+#endif
+
 #include <cds/vector.h>
 
-struct cds_vector_i {
-    size_t size;
-    size_t reserved;
-    size_t type;
+#define _CDS_HUGE_PAGE ((size_t) 2 << 20)
+#define _CDS_HUGE_ROUND(bytes) (((bytes) + _CDS_HUGE_PAGE - 1) & ~(_CDS_HUGE_PAGE - 1))
 
-    size_t mod;
+// data in saved vectors starts at this offset, so it is page aligned
+#define _CDS_FILE_HEADER ((size_t) 4096)
+#define _CDS_FILE_VERSION 1
 
-    struct cds_memory memory;
-    uint8_t* data;
+// where vector data comes from
+enum _cds_storage {
+    _CDS_STORAGE_HEAP,
+    _CDS_STORAGE_THP,
+    _CDS_STORAGE_HUGETLB,
+    _CDS_STORAGE_FILE,
+    _CDS_STORAGE_FILE_READONLY
+};
+
+// header of a saved vector, in native byte order
+struct _cds_vector_file {
+    char magic[8];
+    uint32_t version;
+    uint32_t unused;
+    uint64_t type;
+    uint64_t size;
+    uint64_t alignment;
+    uint64_t checksum;
 };
 
 struct cds_vector_iterdata {
@@ -19,27 +50,66 @@ struct cds_vector_iterdata {
     size_t mod;
 };
 
-static int _cds_reserve(CDS_VECTOR(T) vector);
+static int _cds_reserve(CDS_VECTOR(T) vector, size_t count);
+static void _cds_fill(CDS_VECTOR(T) vector, size_t pos, size_t count, void* initializer);
 static int _cds_shrink(CDS_VECTOR(T) vector);
-
-static CDS_ITER(T) _cds_iter_create(CDS_VECTOR(T) vector, struct cds_vector_iterdata data, bool reverse);
+static int _cds_realloc(CDS_VECTOR(T) vector, size_t capacity);
+static uint8_t* _cds_buffer_alloc(CDS_VECTOR(T) vector, size_t bytes);
+static void _cds_buffer_free(CDS_VECTOR(T) vector);
+static bool _cds_buffer_huge(CDS_VECTOR(T) vector, size_t bytes);
+static uint8_t* _cds_huge_map(size_t bytes, uint8_t* storage);
+static struct cds_vector_config _cds_config(CDS_VECTOR(T) vector);
+static bool _cds_readonly(CDS_VECTOR(T) vector);
+static uint64_t _cds_checksum(const uint8_t* data, size_t bytes);
+
+static CDS_ITER(T) _cds_iter_create(CDS_VECTOR(T) vector, size_t pos, bool reverse);
+static struct cds_vector_iterdata* _cds_iter_state(CDS_ITER(T) iter, CDS_VECTOR(T) vector, size_t pos);
 static bool _cds_iter_hasnext(void* structure, void** data);
 static void* _cds_iter_next(void* structure, void** data);
+static size_t _cds_iter_next_batch(void* structure, void** data, void** out, size_t max);
 static bool _cds_iter_hasback(void* structure, void** data);
 static void* _cds_iter_back(void* structure, void** data);
 static bool _cds_iter_similar(void* data, void* other);
 static size_t _cds_iter_distance(void* data, void* other);
 static bool _cds_iter_valid(void* structure, void* data);
-static void _cds_iter_destroy(void* structure, void* data);
+
+static const struct cds_iter_vtable _cds_iter_forward = {
+    .has_next = _cds_iter_hasnext,
+    .next = _cds_iter_next,
+    .next_batch = _cds_iter_next_batch,
+    .has_back = _cds_iter_hasback,
+    .back = _cds_iter_back,
+    .is_similar = _cds_iter_similar,
+    .distance = _cds_iter_distance,
+    .is_valid = _cds_iter_valid
+};
+
+static const struct cds_iter_vtable _cds_iter_reverse = {
+    .has_next = _cds_iter_hasback,
+    .next = _cds_iter_back,
+    .has_back = _cds_iter_hasnext,
+    .back = _cds_iter_next,
+    .is_similar = _cds_iter_similar,
+    .distance = _cds_iter_distance,
+    .is_valid = _cds_iter_valid
+};
 
 CDS_VECTOR(T) cds_vector_create(struct cds_vector_config config) {
-    if (!cds_memory_valid(config.memory)) {
+    if (!cds_memory_valid(config.memory) || (config.growth_factor != 0 && config.growth_factor <= 1)) {
+        return NULL;
+    }
+
+    if ((config.alignment & (config.alignment - 1)) != 0) {
+        return NULL;
+    }
+    // over-aligned memory needs memory manager support
+    if (config.alignment > _Alignof(max_align_t) && config.memory.aligned_allocator == NULL) {
         return NULL;
     }
 
     struct cds_memory* memory = &config.memory;
 
-    CDS_VECTOR(T) vector = memory->allocator(sizeof(struct cds_vector_i));
+    CDS_VECTOR(T) vector = memory->allocator(memory->context, sizeof(struct cds_vector_i));
 
     if (vector != NULL) {
         vector->size = 0;
@@ -47,13 +117,23 @@ CDS_VECTOR(T) cds_vector_create(struct cds_vector_config config) {
         vector->type = config.type;
 
         vector->mod = 0;
+        vector->reallocs = 0;
+
+        vector->growth_factor = config.growth_factor != 0 ? config.growth_factor : 2;
+        vector->min_capacity = config.min_capacity != 0 ? config.min_capacity : 8;
+        vector->shrink_threshold = config.shrink_threshold != 0 ? config.shrink_threshold : 4;
+        vector->never_shrink = config.never_shrink;
+
+        vector->alignment = config.alignment > _Alignof(max_align_t) ? config.alignment : 0;
+        vector->huge_pages = config.huge_pages;
+        vector->storage = _CDS_STORAGE_HEAP;
 
         vector->memory = *memory;
-        vector->data = memory->allocator(sizeof(uint8_t) * config.type * config.capacity);
+        vector->data = _cds_buffer_alloc(vector, sizeof(uint8_t) * config.type * config.capacity);
 
         // no enough memory to create data
         if (vector->data == NULL) {
-            memory->deallocator(vector);
+            memory->deallocator(memory->context, vector);
             vector = NULL;
         }
     }
@@ -67,15 +147,15 @@ CDS_VECTOR(T) cds_vector_copy(CDS_VECTOR(T) vector, struct cds_memory memory) {
         return NULL;
     }
 
-    struct cds_vector_config config = {
-        .type = vector->type,
-        .capacity = vector->reserved,
-        .memory = memory
-    };
+    struct cds_vector_config config = _cds_config(vector);
+    config.capacity = vector->reserved;
+    config.memory = memory;
+
     CDS_VECTOR(T) other = cds_vector_create(config);
 
     if (other != NULL) {
         memcpy(other->data, vector->data, vector->type * vector->size);
+        other->size = vector->size;
     }
 
     return other;
@@ -86,18 +166,23 @@ CDS_VECTOR(T) cds_vector_from(CDS_VECTOR(T) vector, CDS_ITER(T) begin, CDS_ITER(
         return NULL;
     }
 
+    // fallback iterators live in the stack, nothing to release
+    struct cds_iter_i begin_fallback;
+    struct cds_iter_i end_fallback;
+
     if (!cds_iter_valid(begin)) {
-        begin = cds_vector_begin(vector);
+        cds_vector_iter_init(&begin_fallback, vector);
+        begin = &begin_fallback;
     }
     if (!cds_iter_valid(end)) {
-        end = cds_vector_end(vector);
+        cds_vector_iter_init(&end_fallback, vector);
+        ((struct cds_vector_iterdata*) end_fallback.data)->pos = vector->size;
+        end = &end_fallback;
     }
 
-    struct cds_vector_config config = {
-        .type = vector->type,
-        .capacity = vector->size,
-        .memory = vector->memory
-    };
+    struct cds_vector_config config = _cds_config(vector);
+    config.capacity = vector->size;
+
     CDS_VECTOR(T) other = cds_vector_create(config);
 
     if (other != NULL) {
@@ -116,9 +201,136 @@ void cds_vector_destroy(CDS_VECTOR(T) vector) {
 
     cds_vector_clear(vector);
 
-    cds_deallocator deallocator = vector->memory.deallocator;
-    deallocator(vector->data);
-    deallocator(vector);
+    _cds_buffer_free(vector);
+
+    struct cds_memory memory = vector->memory;
+    memory.deallocator(memory.context, vector);
+}
+
+int cds_vector_save(CDS_VECTOR(T) vector, const char* path) {
+    if (vector == NULL || path == NULL) {
+        return CDS_ERR;
+    }
+
+    // write next to target and rename, readers never see a partial file
+    size_t length = strlen(path);
+    char* temporary = malloc(length + sizeof(".tmp"));
+    if (temporary == NULL) {
+        return CDS_ERR;
+    }
+    memcpy(temporary, path, length);
+    memcpy(&temporary[length], ".tmp", sizeof(".tmp"));
+
+    FILE* file = fopen(temporary, "wb");
+    if (file == NULL) {
+        free(temporary);
+        return CDS_ERR;
+    }
+
+    uint8_t header[_CDS_FILE_HEADER] = {0};
+    struct _cds_vector_file info = {
+        .magic = "CDSVEC",
+        .version = _CDS_FILE_VERSION,
+        .type = vector->type,
+        .size = vector->size,
+        .alignment = vector->alignment,
+        .checksum = _cds_checksum(vector->data, vector->type * vector->size)
+    };
+    memcpy(header, &info, sizeof(info));
+
+    bool written = fwrite(header, 1, sizeof(header), file) == sizeof(header)
+        && fwrite(vector->data, vector->type, vector->size, file) == vector->size;
+
+    if (fclose(file) != 0 || !written || rename(temporary, path) != 0) {
+        remove(temporary);
+        free(temporary);
+        return CDS_ERR;
+    }
+
+    free(temporary);
+    return CDS_OK;
+}
+
+CDS_VECTOR(T) cds_vector_open_mapped(const char* path, int mode) {
+#ifdef _CDS_MMAP
+    if (path == NULL) {
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || (size_t) status.st_size < _CDS_FILE_HEADER) {
+        close(fd);
+        return NULL;
+    }
+
+    // copy on write pages can be written, changes never reach the file
+    bool copy = (mode & CDS_VECTOR_MAP_COPY) != 0;
+    size_t length = (size_t) status.st_size;
+    uint8_t* base = mmap(NULL, length, copy ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+
+    struct _cds_vector_file info;
+    memcpy(&info, base, sizeof(info));
+
+    uint8_t* data = base + _CDS_FILE_HEADER;
+    bool valid = memcmp(info.magic, "CDSVEC", sizeof("CDSVEC")) == 0
+        && info.version == _CDS_FILE_VERSION
+        && info.type != 0
+        && info.size <= (length - _CDS_FILE_HEADER) / info.type
+        && (info.alignment == 0 || (uintptr_t) data % info.alignment == 0);
+
+    if (valid && (mode & CDS_VECTOR_MAP_VERIFY) != 0) {
+        valid = _cds_checksum(data, info.type * info.size) == info.checksum;
+    }
+
+    struct cds_memory memory = cds_memory_system();
+    CDS_VECTOR(T) vector = valid ? memory.allocator(memory.context, sizeof(struct cds_vector_i)) : NULL;
+
+    if (vector == NULL) {
+        munmap(base, length);
+        return NULL;
+    }
+
+    struct cds_vector_i mapped = {
+        .size = info.size,
+        .reserved = info.size,
+        .type = info.type,
+        .growth_factor = 2,
+        .min_capacity = 8,
+        .shrink_threshold = 4,
+        .alignment = info.alignment,
+        .storage = copy ? _CDS_STORAGE_FILE : _CDS_STORAGE_FILE_READONLY,
+        .memory = memory,
+        .data = data
+    };
+    *vector = mapped;
+
+    if (length > _CDS_FILE_HEADER + info.type * info.size) {
+        // trailing bytes are not ours, keep only what destroy will unmap
+        size_t page = (size_t) sysconf(_SC_PAGESIZE);
+        size_t used = (_CDS_FILE_HEADER + info.type * info.size + page - 1) / page * page;
+        if (used < length) {
+            munmap(base + used, length - used);
+        }
+    }
+
+    return vector;
+#else
+    return NULL;
+#endif
+}
+
+bool cds_vector_readonly(CDS_VECTOR(T) vector) {
+    return vector != NULL && vector->storage == _CDS_STORAGE_FILE_READONLY;
 }
 
 int cds_vector_at(CDS_VECTOR(T) vector, size_t pos, void* out) {
@@ -130,6 +342,18 @@ int cds_vector_at(CDS_VECTOR(T) vector, size_t pos, void* out) {
     return CDS_OK;
 }
 
+CDS_OBJ(T) cds_vector_ptr_at(CDS_VECTOR(T) vector, size_t pos) {
+    if (vector == NULL || pos >= vector->size) {
+        return NULL;
+    }
+
+    return &vector->data[vector->type * pos];
+}
+
+CDS_OBJ(T) cds_vector_data(CDS_VECTOR(T) vector) {
+    return vector != NULL ? vector->data : NULL;
+}
+
 int cds_vector_front(CDS_VECTOR(T) vector, void* out) {
     return cds_vector_at(vector, 0, out);
 }
@@ -143,8 +367,7 @@ CDS_ITER(T) cds_vector_begin(CDS_VECTOR(T) vector) {
         return NULL;
     }
 
-    struct cds_vector_iterdata data = {.pos = 0};
-    return _cds_iter_create(vector, data, false);
+    return _cds_iter_create(vector, 0, false);
 }
 
 CDS_ITER(T) cds_vector_rbegin(CDS_VECTOR(T) vector) {
@@ -152,8 +375,7 @@ CDS_ITER(T) cds_vector_rbegin(CDS_VECTOR(T) vector) {
         return NULL;
     }
 
-    struct cds_vector_iterdata data = {.pos = vector->size};
-    return _cds_iter_create(vector, data, true);
+    return _cds_iter_create(vector, vector->size, true);
 }
 
 CDS_ITER(T) cds_vector_end(CDS_VECTOR(T) vector) {
@@ -161,8 +383,7 @@ CDS_ITER(T) cds_vector_end(CDS_VECTOR(T) vector) {
         return NULL;
     }
 
-    struct cds_vector_iterdata data = {.pos = vector->size};
-    return _cds_iter_create(vector, data, false);
+    return _cds_iter_create(vector, vector->size, false);
 }
 
 CDS_ITER(T) cds_vector_rend(CDS_VECTOR(T) vector) {
@@ -170,8 +391,23 @@ CDS_ITER(T) cds_vector_rend(CDS_VECTOR(T) vector) {
         return NULL;
     }
 
-    struct cds_vector_iterdata data = {.pos = vector->size};
-    return _cds_iter_create(vector, data, true);
+    return _cds_iter_create(vector, vector->size, true);
+}
+
+void cds_vector_iter_init(CDS_ITER(T) iter, CDS_VECTOR(T) vector) {
+    if (iter == NULL || vector == NULL) {
+        return;
+    }
+
+    cds_iter_init(iter, vector, &_cds_iter_forward, _cds_iter_state(iter, vector, 0));
+}
+
+void cds_vector_riter_init(CDS_ITER(T) iter, CDS_VECTOR(T) vector) {
+    if (iter == NULL || vector == NULL) {
+        return;
+    }
+
+    cds_iter_init(iter, vector, &_cds_iter_reverse, _cds_iter_state(iter, vector, vector->size));
 }
 
 bool cds_vector_empty(CDS_VECTOR(T) vector) {
@@ -191,37 +427,32 @@ int cds_vector_reserve(CDS_VECTOR(T) vector, size_t capacity) {
         return CDS_OK;
     }
 
-    cds_reallocator reallocator = vector->memory.reallocator;
-    uint8_t* new_data = reallocator(vector->data, sizeof(uint8_t) * vector->type * capacity);
+    return _cds_realloc(vector, capacity);
+}
 
-    if (new_data == NULL) {
+int cds_vector_grow(CDS_VECTOR(T) vector, size_t count) {
+    if (vector == NULL) {
         return CDS_ERR;
     }
 
-    vector->reserved = capacity;
-    vector->data = new_data;
-
-    return CDS_OK;
+    return _cds_reserve(vector, count);
 }
 
 size_t cds_vector_capacity(CDS_VECTOR(T) vector) {
     return vector != NULL ? vector->reserved : 0;
 }
 
+size_t cds_vector_reallocs(CDS_VECTOR(T) vector) {
+    return vector != NULL ? vector->reallocs : 0;
+}
+
 void cds_vector_shrink(CDS_VECTOR(T) vector) {
     if (vector == NULL || vector->size >= vector->reserved) {
         return;
     }
 
-    cds_reallocator reallocator = vector->memory.reallocator;
-    uint8_t* new_data = reallocator(vector->data, sizeof(uint8_t) * vector->type * vector->size);
-
-    if (new_data == NULL) {
-        return;
-    }
-
-    vector->reserved = vector->size;
-    vector->data = new_data;
+    // keep at least an element, reallocating to 0 bytes may free buffer
+    _cds_realloc(vector, vector->size != 0 ? vector->size : 1);
 }
 
 void cds_vector_clear(CDS_VECTOR(T) vector) {
@@ -238,7 +469,7 @@ int cds_vector_insert(CDS_VECTOR(T) vector, size_t pos, void* data) {
         return CDS_ERR;
     }
 
-    if (_cds_reserve(vector) != CDS_OK) {
+    if (_cds_reserve(vector, 1) != CDS_OK) {
         return CDS_ERR;
     }
 
@@ -252,7 +483,7 @@ int cds_vector_insert(CDS_VECTOR(T) vector, size_t pos, void* data) {
 }
 
 int cds_vector_erase(CDS_VECTOR(T) vector, size_t pos) {
-    if (vector == NULL || pos >= vector->size) {
+    if (vector == NULL || pos >= vector->size || _cds_readonly(vector)) {
         return CDS_ERR;
     }
 
@@ -273,7 +504,7 @@ int cds_vector_pushback(CDS_VECTOR(T) vector, void* data) {
         return CDS_ERR;
     }
 
-    if (_cds_reserve(vector) != CDS_OK) {
+    if (_cds_reserve(vector, 1) != CDS_OK) {
         return CDS_ERR;
     }
 
@@ -285,6 +516,21 @@ int cds_vector_pushback(CDS_VECTOR(T) vector, void* data) {
     return CDS_OK;
 }
 
+CDS_OBJ(T) cds_vector_emplace_back(CDS_VECTOR(T) vector) {
+    if (vector == NULL) {
+        return NULL;
+    }
+
+    if (_cds_reserve(vector, 1) != CDS_OK) {
+        return NULL;
+    }
+
+    vector->size++;
+    vector->mod++;
+
+    return &vector->data[vector->type * (vector->size - 1)];
+}
+
 int cds_vector_popback(CDS_VECTOR(T) vector, void* out) {
     if (vector == NULL || vector->size == 0) {
         return CDS_ERR;
@@ -293,7 +539,9 @@ int cds_vector_popback(CDS_VECTOR(T) vector, void* out) {
     vector->size--;
     vector->mod++;
 
-    memcpy(out, &vector->data[vector->type * vector->size], vector->type);
+    if (out != NULL) {
+        memcpy(out, &vector->data[vector->type * vector->size], vector->type);
+    }
     _cds_shrink(vector);
 
     return CDS_OK;
@@ -305,22 +553,76 @@ int cds_vector_resize(CDS_VECTOR(T) vector, size_t count, void* initializer) {
     }
 
     if (count > vector->size) {
-        if (cds_vector_reserve(vector, count) != CDS_OK) {
+        if (_cds_readonly(vector) || cds_vector_reserve(vector, count) != CDS_OK) {
             return CDS_ERR;
         }
 
-        for (size_t i = vector->size; i < count; i++) {
-            cds_vector_pushback(vector, initializer);
-        }
+        _cds_fill(vector, vector->size, count - vector->size, initializer);
+        vector->size = count;
+        vector->mod++;
     } else if (count < vector->size) {
-        for (size_t i = count; i < vector->size; i++) {
-            cds_vector_erase(vector, i);
-        }
+        vector->size = count;
+        vector->mod++;
+
+        _cds_shrink(vector);
     }
 
     return CDS_OK;
 }
 
+int cds_vector_append_n(CDS_VECTOR(T) vector, void* data, size_t count) {
+    if (vector == NULL) {
+        return CDS_ERR;
+    }
+
+    return cds_vector_insert_range(vector, vector->size, data, count);
+}
+
+int cds_vector_insert_range(CDS_VECTOR(T) vector, size_t pos, void* data, size_t count) {
+    if (vector == NULL || pos > vector->size || (data == NULL && count > 0)) {
+        return CDS_ERR;
+    }
+
+    if (count == 0) {
+        return CDS_OK;
+    }
+
+    if (_cds_reserve(vector, count) != CDS_OK) {
+        return CDS_ERR;
+    }
+
+    if (vector->size > pos) {
+        memmove(&vector->data[vector->type * (pos + count)], &vector->data[vector->type * pos], vector->type * (vector->size - pos));
+    }
+    memcpy(&vector->data[vector->type * pos], data, vector->type * count);
+
+    vector->size += count;
+    vector->mod++;
+
+    return CDS_OK;
+}
+
+int cds_vector_erase_range(CDS_VECTOR(T) vector, size_t first, size_t last) {
+    if (vector == NULL || first > last || last > vector->size || _cds_readonly(vector)) {
+        return CDS_ERR;
+    }
+
+    if (first == last) {
+        return CDS_OK;
+    }
+
+    if (vector->size > last) {
+        memmove(&vector->data[vector->type * first], &vector->data[vector->type * last], vector->type * (vector->size - last));
+    }
+
+    vector->size -= last - first;
+    vector->mod++;
+
+    _cds_shrink(vector);
+
+    return CDS_OK;
+}
+
 int cds_vector_swap(CDS_VECTOR(T) vector, CDS_VECTOR(T) other) {
     if (vector == NULL || other == NULL) {
         return CDS_ERR;
@@ -336,61 +638,267 @@ int cds_vector_swap(CDS_VECTOR(T) vector, CDS_VECTOR(T) other) {
     return CDS_OK;
 }
 
-static int _cds_reserve(CDS_VECTOR(T) vector) {
+static int _cds_reserve(CDS_VECTOR(T) vector, size_t count) {
+    if (_cds_readonly(vector)) {
+        return CDS_ERR;
+    }
+
     size_t size = vector->size;
-    if (vector->reserved > size) {
+    if (vector->reserved - size >= count) {
         return CDS_OK;
     }
 
-    int (*reserver)(cds_vector, size_t) = cds_vector_reserve;
-    return size > 0 ? reserver(vector, size * 2) : reserver(vector, 8);
+    if (count > SIZE_MAX / vector->type - size) {
+        return CDS_ERR;
+    }
+
+    // keep growing geometrically unless a bulk insertion needs more than that
+    double grown = vector->reserved * vector->growth_factor;
+    size_t capacity = grown < (double) (SIZE_MAX / vector->type) ? (size_t) grown : SIZE_MAX / vector->type;
+
+    if (capacity < vector->min_capacity) {
+        capacity = vector->min_capacity;
+    }
+    if (capacity < size + count) {
+        capacity = size + count;
+    }
+
+    return cds_vector_reserve(vector, capacity);
+}
+
+static void _cds_fill(CDS_VECTOR(T) vector, size_t pos, size_t count, void* initializer) {
+    uint8_t* begin = &vector->data[vector->type * pos];
+    size_t bytes = vector->type * count;
+
+    if (initializer == NULL) {
+        memset(begin, 0, bytes);
+        return;
+    }
+
+    if (count == 0) {
+        return;
+    }
+
+    // copy from the filled prefix, doubling it each pass
+    memcpy(begin, initializer, vector->type);
+    for (size_t filled = vector->type; filled < bytes; filled *= 2) {
+        memcpy(&begin[filled], begin, filled < bytes - filled ? filled : bytes - filled);
+    }
 }
 
 static int _cds_shrink(CDS_VECTOR(T) vector) {
-    if (vector->size != 0 && vector->reserved / vector->size < 4) {
+    if (vector->never_shrink || vector->reserved <= vector->min_capacity) {
         return CDS_OK;
     }
 
-    cds_reallocator reallocator = vector->memory.reallocator;
+    size_t size = vector->size;
+    if (size != 0 && vector->reserved / size < vector->shrink_threshold) {
+        return CDS_OK;
+    }
+
+    // leave room to grow back, so push/pop around a boundary does not
+    // reallocate each time
+    double target = size * vector->growth_factor;
+    size_t new_reserved = target < (double) vector->reserved ? (size_t) target : vector->reserved;
+
+    if (new_reserved < vector->min_capacity) {
+        new_reserved = vector->min_capacity;
+    }
+    if (new_reserved >= vector->reserved) {
+        return CDS_OK;
+    }
 
-    size_t new_reserved = vector->size != 0 ? vector->reserved / 2 : 0;
-    uint8_t* new_data = reallocator(vector->data, sizeof(uint8_t) * vector->type * new_reserved);
+    return _cds_realloc(vector, new_reserved);
+}
 
-    if (new_data == NULL) {
+static int _cds_realloc(CDS_VECTOR(T) vector, size_t capacity) {
+    if (_cds_readonly(vector)) {
         return CDS_ERR;
     }
 
-    vector->reserved = new_reserved;
+    struct cds_memory* memory = &vector->memory;
+    size_t bytes = sizeof(uint8_t) * vector->type * capacity;
+    uint8_t* new_data = NULL;
+
+#ifdef _CDS_HUGE_PAGES
+    if (vector->storage == _CDS_STORAGE_THP) {
+        // pages are remapped, not copied
+        size_t old_length = _CDS_HUGE_ROUND(vector->type * vector->reserved);
+        new_data = mremap(vector->data, old_length, _CDS_HUGE_ROUND(bytes), MREMAP_MAYMOVE);
+
+        if (new_data == MAP_FAILED) {
+            return CDS_ERR;
+        }
+        madvise(new_data, _CDS_HUGE_ROUND(bytes), MADV_HUGEPAGE);
+    } else
+#endif
+    if (vector->storage != _CDS_STORAGE_HEAP || vector->alignment != 0 || _cds_buffer_huge(vector, bytes)) {
+        // storage may change, so move elements to a new buffer
+        struct cds_vector_i moved = *vector;
+        new_data = _cds_buffer_alloc(&moved, bytes);
+
+        if (new_data == NULL) {
+            return CDS_ERR;
+        }
+
+        size_t used = vector->size < capacity ? vector->size : capacity;
+        memcpy(new_data, vector->data, vector->type * used);
+
+        _cds_buffer_free(vector);
+        vector->storage = moved.storage;
+    } else {
+        new_data = memory->reallocator(memory->context, vector->data, bytes);
+
+        if (new_data == NULL) {
+            return CDS_ERR;
+        }
+    }
+
+    vector->reserved = capacity;
     vector->data = new_data;
+    vector->reallocs++;
 
     return CDS_OK;
 }
 
-static CDS_ITER(T) _cds_iter_create(CDS_VECTOR(T) vector, struct cds_vector_iterdata data, bool reverse) {
+static uint8_t* _cds_buffer_alloc(CDS_VECTOR(T) vector, size_t bytes) {
+    struct cds_memory* memory = &vector->memory;
+
+    if (_cds_buffer_huge(vector, bytes)) {
+        uint8_t* data = _cds_huge_map(bytes, &vector->storage);
+
+        // fallback to memory manager if kernel refuses
+        if (data != NULL) {
+            return data;
+        }
+    }
+
+    vector->storage = _CDS_STORAGE_HEAP;
+
+    if (vector->alignment != 0) {
+        return memory->aligned_allocator(memory->context, vector->alignment, bytes);
+    }
+
+    return memory->allocator(memory->context, bytes);
+}
+
+static void _cds_buffer_free(CDS_VECTOR(T) vector) {
+#ifdef _CDS_MMAP
+    if (vector->storage == _CDS_STORAGE_FILE || vector->storage == _CDS_STORAGE_FILE_READONLY) {
+        munmap(vector->data - _CDS_FILE_HEADER, _CDS_FILE_HEADER + vector->type * vector->reserved);
+        return;
+    }
+#endif
+#ifdef _CDS_HUGE_PAGES
+    if (vector->storage != _CDS_STORAGE_HEAP) {
+        munmap(vector->data, _CDS_HUGE_ROUND(vector->type * vector->reserved));
+        return;
+    }
+#endif
+
     struct cds_memory* memory = &vector->memory;
-    struct cds_vector_iterdata* iterdata = memory->allocator(sizeof(struct cds_vector_iterdata));
+    memory->deallocator(memory->context, vector->data);
+}
+
+static bool _cds_buffer_huge(CDS_VECTOR(T) vector, size_t bytes) {
+#ifdef _CDS_HUGE_PAGES
+    return vector->huge_pages && bytes >= _CDS_HUGE_PAGE;
+#else
+    return false;
+#endif
+}
 
-    if (iterdata == NULL) {
+static uint8_t* _cds_huge_map(size_t bytes, uint8_t* storage) {
+#ifdef _CDS_HUGE_PAGES
+    size_t length = _CDS_HUGE_ROUND(bytes);
+
+    // explicit huge pages only work if administrator reserved them
+    uint8_t* data = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (data != MAP_FAILED) {
+        *storage = _CDS_STORAGE_HUGETLB;
+        return data;
+    }
+
+    // otherwise ask for transparent huge pages on a 2 MiB aligned range
+    data = mmap(NULL, length + _CDS_HUGE_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED) {
         return NULL;
     }
 
-    memcpy(iterdata, &data, sizeof(struct cds_vector_iterdata));
-    iterdata->mod = vector->mod;
+    size_t head = (_CDS_HUGE_PAGE - (uintptr_t) data % _CDS_HUGE_PAGE) % _CDS_HUGE_PAGE;
+    if (head != 0) {
+        munmap(data, head);
+    }
+    munmap(data + head + length, _CDS_HUGE_PAGE - head);
 
+    data += head;
+    madvise(data, length, MADV_HUGEPAGE);
+
+    *storage = _CDS_STORAGE_THP;
+    return data;
+#else
+    return NULL;
+#endif
+}
+
+static struct cds_vector_config _cds_config(CDS_VECTOR(T) vector) {
+    return (struct cds_vector_config) {
+        .type = vector->type,
+        .capacity = vector->reserved,
+        .memory = vector->memory,
+        .growth_factor = vector->growth_factor,
+        .min_capacity = vector->min_capacity,
+        .shrink_threshold = vector->shrink_threshold,
+        .never_shrink = vector->never_shrink,
+        .alignment = vector->alignment,
+        .huge_pages = vector->huge_pages
+    };
+}
+
+static bool _cds_readonly(CDS_VECTOR(T) vector) {
+    return cds_vector_readonly(vector);
+}
+
+static uint64_t _cds_checksum(const uint8_t* data, size_t bytes) {
+    // FNV-1a taking 8 bytes per step
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+    size_t i = 0;
+
+    for (; i + sizeof(uint64_t) <= bytes; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, &data[i], sizeof(uint64_t));
+        hash = (hash ^ word) * UINT64_C(0x100000001b3);
+    }
+    for (; i < bytes; i++) {
+        hash = (hash ^ data[i]) * UINT64_C(0x100000001b3);
+    }
+
+    return hash;
+}
+
+static CDS_ITER(T) _cds_iter_create(CDS_VECTOR(T) vector, size_t pos, bool reverse) {
     struct cds_iter_config config = {
-        .memory = *memory,
-        .initial_data = iterdata,
-        .has_next = reverse ? _cds_iter_hasback : _cds_iter_hasnext,
-        .next = reverse ? _cds_iter_back : _cds_iter_next,
-        .has_back = reverse ? _cds_iter_hasnext : _cds_iter_hasback,
-        .back = reverse ? _cds_iter_next : _cds_iter_back,
-        .is_similar = _cds_iter_similar,
-        .distance = _cds_iter_distance,
-        .is_valid = _cds_iter_valid,
-        .destroy = _cds_iter_destroy
+        .memory = vector->memory,
+        .vtable = reverse ? &_cds_iter_reverse : &_cds_iter_forward
     };
 
-    return cds_iter_create(vector, config);
+    CDS_ITER(T) iter = cds_iter_create(vector, config);
+
+    if (iter != NULL) {
+        iter->data = _cds_iter_state(iter, vector, pos);
+    }
+
+    return iter;
+}
+
+static struct cds_vector_iterdata* _cds_iter_state(CDS_ITER(T) iter, CDS_VECTOR(T) vector, size_t pos) {
+    // iterator data lives inside the iterator, no allocation needed
+    struct cds_vector_iterdata* iterdata = (struct cds_vector_iterdata*) iter->state;
+
+    iterdata->pos = pos;
+    iterdata->mod = vector->mod;
+
+    return iterdata;
 }
 
 static bool _cds_iter_hasnext(void* structure, void** data) {
@@ -423,6 +931,28 @@ static void* _cds_iter_next(void* structure, void** data) {
     return &vector->data[vector->type * iterdata->pos++];
 }
 
+static size_t _cds_iter_next_batch(void* structure, void** data, void** out, size_t max) {
+    if (structure == NULL || data == NULL) {
+        return 0;
+    }
+
+    CDS_VECTOR(T) vector = structure;
+    struct cds_vector_iterdata* iterdata = *data;
+
+    if (iterdata == NULL || vector->mod != iterdata->mod || iterdata->pos >= vector->size) {
+        return 0;
+    }
+
+    // rest of buffer, modification counter is checked once per run
+    size_t count = vector->size - iterdata->pos;
+    count = count < max ? count : max;
+
+    *out = &vector->data[vector->type * iterdata->pos];
+    iterdata->pos += count;
+
+    return count;
+}
+
 static bool _cds_iter_hasback(void* structure, void** data) {
     if (structure == NULL || data == NULL) {
         return false;
@@ -485,13 +1015,3 @@ static bool _cds_iter_valid(void* structure, void* data) {
 
     return vector->mod == iterdata->mod;
 }
-
-static void _cds_iter_destroy(void* structure, void* data) {
-    if (structure == NULL) {
-        return;
-    }
-
-    CDS_VECTOR(T) vector = structure;
-    vector->memory.deallocator(data);
-}
-
@@ -0,0 +1,514 @@
+#include <math.h>
+#include <stdint.h>
+
+#include <cds/vector.h>
+
+#include "vector_kernels.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define _CDS_X86 1
+#endif
+
+static const struct _cds_kernels* _cds_kernels();
+
+/*
+ * Kernel templates.
+ *
+ * Every template takes a target attribute, lane count and the ISA specific
+ * operations, and ends with a scalar loop for the tail, so the scalar
+ * fallback is the same template with one lane.
+ */
+
+#define _CDS_FIND(name, target, ctype, vtype, lanes, set1, load, eqmask)      \
+    target static size_t name(const ctype* data, size_t size, ctype value) {  \
+        vtype needle = set1(value);                                           \
+        size_t i = 0;                                                         \
+        for (; i + lanes <= size; i += lanes) {                               \
+            unsigned int mask = eqmask(load(&data[i]), needle);               \
+            if (mask != 0) {                                                  \
+                return i + __builtin_ctz(mask);                               \
+            }                                                                 \
+        }                                                                     \
+        for (; i < size; i++) {                                               \
+            if (data[i] == value) {                                           \
+                return i;                                                     \
+            }                                                                 \
+        }                                                                     \
+        return CDS_VECTOR_NPOS;                                               \
+    }
+
+#define _CDS_COUNT(name, target, ctype, vtype, lanes, set1, load, eqmask)     \
+    target static size_t name(const ctype* data, size_t size, ctype value) {  \
+        vtype needle = set1(value);                                           \
+        size_t count = 0;                                                     \
+        size_t i = 0;                                                         \
+        for (; i + lanes <= size; i += lanes) {                               \
+            count += __builtin_popcount(eqmask(load(&data[i]), needle));      \
+        }                                                                     \
+        for (; i < size; i++) {                                               \
+            count += data[i] == value;                                        \
+        }                                                                     \
+        return count;                                                         \
+    }
+
+// op(element, accumulator) keeps accumulator if element is NaN
+#define _CDS_REDUCE(name, target, ctype, vtype, lanes, set1, load, store, op, better, identity) \
+    target static ctype name(const ctype* data, size_t size) {                \
+        vtype acc = set1(identity);                                           \
+        size_t i = 0;                                                         \
+        for (; i + lanes <= size; i += lanes) {                               \
+            acc = op(load(&data[i]), acc);                                    \
+        }                                                                     \
+        ctype partial[lanes];                                                 \
+        store(partial, acc);                                                  \
+        ctype result = identity;                                              \
+        for (size_t lane = 0; lane < lanes; lane++) {                         \
+            if (better(partial[lane], result)) {                              \
+                result = partial[lane];                                       \
+            }                                                                 \
+        }                                                                     \
+        for (; i < size; i++) {                                               \
+            if (better(data[i], result)) {                                    \
+                result = data[i];                                             \
+            }                                                                 \
+        }                                                                     \
+        return result;                                                        \
+    }
+
+// widen(vector, accumulator) adds elements into a wider accumulator
+#define _CDS_SUM(name, target, ctype, rtype, vtype, lanes, wide, zero, load, widen, store) \
+    target static rtype name(const ctype* data, size_t size) {                \
+        vtype acc = zero();                                                   \
+        size_t i = 0;                                                         \
+        for (; i + lanes <= size; i += lanes) {                               \
+            acc = widen(load(&data[i]), acc);                                 \
+        }                                                                     \
+        rtype partial[wide];                                                  \
+        store(partial, acc);                                                  \
+        rtype result = 0;                                                     \
+        for (size_t lane = 0; lane < wide; lane++) {                          \
+            result = _cds_add_##rtype(result, partial[lane]);                 \
+        }                                                                     \
+        for (; i < size; i++) {                                               \
+            result = _cds_add_##rtype(result, data[i]);                       \
+        }                                                                     \
+        return result;                                                        \
+    }
+
+#define _CDS_LESS(a, b) ((a) < (b))
+#define _CDS_GREATER(a, b) ((a) > (b))
+
+// integer sums wrap around instead of overflowing
+static inline int64_t _cds_add_int64_t(int64_t a, int64_t b) {
+    return (int64_t) ((uint64_t) a + (uint64_t) b);
+}
+
+static inline double _cds_add_double(double a, double b) {
+    return a + b;
+}
+
+// scalar, one lane
+#define _CDS_NOTARGET
+#define _CDS_S_SET1(value) (value)
+#define _CDS_S_LOAD(ptr) (*(ptr))
+#define _CDS_S_STORE(ptr, value) (*(ptr) = (value))
+#define _CDS_S_EQ(a, b) ((unsigned int) ((a) == (b)))
+#define _CDS_S_MIN(a, b) ((a) < (b) ? (a) : (b))
+#define _CDS_S_MAX(a, b) ((a) > (b) ? (a) : (b))
+#define _CDS_S_ZERO() 0
+#define _CDS_S_ADD_I(a, acc) _cds_add_int64_t(acc, a)
+#define _CDS_S_ADD_F(a, acc) ((acc) + (a))
+
+_CDS_FIND(_cds_find_i32, _CDS_NOTARGET, int32_t, int32_t, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_EQ)
+_CDS_FIND(_cds_find_i64, _CDS_NOTARGET, int64_t, int64_t, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_EQ)
+_CDS_FIND(_cds_find_f32, _CDS_NOTARGET, float, float, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_EQ)
+_CDS_FIND(_cds_find_f64, _CDS_NOTARGET, double, double, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_EQ)
+
+_CDS_COUNT(_cds_count_i32, _CDS_NOTARGET, int32_t, int32_t, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_EQ)
+_CDS_COUNT(_cds_count_i64, _CDS_NOTARGET, int64_t, int64_t, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_EQ)
+_CDS_COUNT(_cds_count_f32, _CDS_NOTARGET, float, float, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_EQ)
+_CDS_COUNT(_cds_count_f64, _CDS_NOTARGET, double, double, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_EQ)
+
+_CDS_REDUCE(_cds_min_i32, _CDS_NOTARGET, int32_t, int32_t, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_STORE, _CDS_S_MIN, _CDS_LESS, INT32_MAX)
+_CDS_REDUCE(_cds_min_i64, _CDS_NOTARGET, int64_t, int64_t, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_STORE, _CDS_S_MIN, _CDS_LESS, INT64_MAX)
+_CDS_REDUCE(_cds_min_f32, _CDS_NOTARGET, float, float, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_STORE, _CDS_S_MIN, _CDS_LESS, INFINITY)
+_CDS_REDUCE(_cds_min_f64, _CDS_NOTARGET, double, double, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_STORE, _CDS_S_MIN, _CDS_LESS, INFINITY)
+
+_CDS_REDUCE(_cds_max_i32, _CDS_NOTARGET, int32_t, int32_t, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_STORE, _CDS_S_MAX, _CDS_GREATER, INT32_MIN)
+_CDS_REDUCE(_cds_max_i64, _CDS_NOTARGET, int64_t, int64_t, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_STORE, _CDS_S_MAX, _CDS_GREATER, INT64_MIN)
+_CDS_REDUCE(_cds_max_f32, _CDS_NOTARGET, float, float, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_STORE, _CDS_S_MAX, _CDS_GREATER, -INFINITY)
+_CDS_REDUCE(_cds_max_f64, _CDS_NOTARGET, double, double, 1, _CDS_S_SET1, _CDS_S_LOAD, _CDS_S_STORE, _CDS_S_MAX, _CDS_GREATER, -INFINITY)
+
+_CDS_SUM(_cds_sum_i32, _CDS_NOTARGET, int32_t, int64_t, int64_t, 1, 1, _CDS_S_ZERO, _CDS_S_LOAD, _CDS_S_ADD_I, _CDS_S_STORE)
+_CDS_SUM(_cds_sum_i64, _CDS_NOTARGET, int64_t, int64_t, int64_t, 1, 1, _CDS_S_ZERO, _CDS_S_LOAD, _CDS_S_ADD_I, _CDS_S_STORE)
+_CDS_SUM(_cds_sum_f32, _CDS_NOTARGET, float, double, double, 1, 1, _CDS_S_ZERO, _CDS_S_LOAD, _CDS_S_ADD_F, _CDS_S_STORE)
+_CDS_SUM(_cds_sum_f64, _CDS_NOTARGET, double, double, double, 1, 1, _CDS_S_ZERO, _CDS_S_LOAD, _CDS_S_ADD_F, _CDS_S_STORE)
+
+static const struct _cds_kernels _cds_kernels_scalar = {
+    _cds_find_i32, _cds_find_i64, _cds_find_f32, _cds_find_f64,
+    _cds_count_i32, _cds_count_i64, _cds_count_f32, _cds_count_f64,
+    _cds_min_i32, _cds_min_i64, _cds_min_f32, _cds_min_f64,
+    _cds_max_i32, _cds_max_i64, _cds_max_f32, _cds_max_f64,
+    _cds_sum_i32, _cds_sum_i64, _cds_sum_f32, _cds_sum_f64
+};
+
+#ifdef _CDS_X86
+// SSE2, 128 bits, every x86-64 CPU has it
+#define _CDS_SSE2 __attribute__((target("sse2")))
+#define _CDS_SSE2_LOADI(ptr) _mm_loadu_si128((const __m128i*) (ptr))
+#define _CDS_SSE2_STOREI(ptr, value) _mm_storeu_si128((__m128i*) (ptr), value)
+#define _CDS_SSE2_EQ32(a, b) ((unsigned int) _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))))
+#define _CDS_SSE2_EQPS(a, b) ((unsigned int) _mm_movemask_ps(_mm_cmpeq_ps(a, b)))
+#define _CDS_SSE2_EQPD(a, b) ((unsigned int) _mm_movemask_pd(_mm_cmpeq_pd(a, b)))
+#define _CDS_SSE2_ADDPS(a, acc) _mm_add_pd(_mm_add_pd(acc, _mm_cvtps_pd(a)), _mm_cvtps_pd(_mm_movehl_ps(a, a)))
+
+// no 64-bit compare, both 32-bit halves must be equal
+_CDS_SSE2 static inline unsigned int _cds_sse2_eq64(__m128i a, __m128i b) {
+    __m128i equal = _mm_cmpeq_epi32(a, b);
+    equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (unsigned int) _mm_movemask_pd(_mm_castsi128_pd(equal));
+}
+
+// no 32-bit min/max either, lanes are picked with a compare mask
+_CDS_SSE2 static inline __m128i _cds_sse2_min32(__m128i a, __m128i acc) {
+    __m128i greater = _mm_cmpgt_epi32(a, acc);
+    return _mm_or_si128(_mm_and_si128(greater, acc), _mm_andnot_si128(greater, a));
+}
+
+_CDS_SSE2 static inline __m128i _cds_sse2_max32(__m128i a, __m128i acc) {
+    __m128i greater = _mm_cmpgt_epi32(a, acc);
+    return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, acc));
+}
+
+// elements are sign extended with their own sign mask
+_CDS_SSE2 static inline __m128i _cds_sse2_add32(__m128i a, __m128i acc) {
+    __m128i sign = _mm_srai_epi32(a, 31);
+    acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(a, sign));
+    return _mm_add_epi64(acc, _mm_unpackhi_epi32(a, sign));
+}
+
+_CDS_FIND(_cds_sse2_find_i32, _CDS_SSE2, int32_t, __m128i, 4, _mm_set1_epi32, _CDS_SSE2_LOADI, _CDS_SSE2_EQ32)
+_CDS_FIND(_cds_sse2_find_i64, _CDS_SSE2, int64_t, __m128i, 2, _mm_set1_epi64x, _CDS_SSE2_LOADI, _cds_sse2_eq64)
+_CDS_FIND(_cds_sse2_find_f32, _CDS_SSE2, float, __m128, 4, _mm_set1_ps, _mm_loadu_ps, _CDS_SSE2_EQPS)
+_CDS_FIND(_cds_sse2_find_f64, _CDS_SSE2, double, __m128d, 2, _mm_set1_pd, _mm_loadu_pd, _CDS_SSE2_EQPD)
+
+_CDS_COUNT(_cds_sse2_count_i32, _CDS_SSE2, int32_t, __m128i, 4, _mm_set1_epi32, _CDS_SSE2_LOADI, _CDS_SSE2_EQ32)
+_CDS_COUNT(_cds_sse2_count_i64, _CDS_SSE2, int64_t, __m128i, 2, _mm_set1_epi64x, _CDS_SSE2_LOADI, _cds_sse2_eq64)
+_CDS_COUNT(_cds_sse2_count_f32, _CDS_SSE2, float, __m128, 4, _mm_set1_ps, _mm_loadu_ps, _CDS_SSE2_EQPS)
+_CDS_COUNT(_cds_sse2_count_f64, _CDS_SSE2, double, __m128d, 2, _mm_set1_pd, _mm_loadu_pd, _CDS_SSE2_EQPD)
+
+_CDS_REDUCE(_cds_sse2_min_i32, _CDS_SSE2, int32_t, __m128i, 4, _mm_set1_epi32, _CDS_SSE2_LOADI, _CDS_SSE2_STOREI, _cds_sse2_min32, _CDS_LESS, INT32_MAX)
+_CDS_REDUCE(_cds_sse2_min_f32, _CDS_SSE2, float, __m128, 4, _mm_set1_ps, _mm_loadu_ps, _mm_storeu_ps, _mm_min_ps, _CDS_LESS, INFINITY)
+_CDS_REDUCE(_cds_sse2_min_f64, _CDS_SSE2, double, __m128d, 2, _mm_set1_pd, _mm_loadu_pd, _mm_storeu_pd, _mm_min_pd, _CDS_LESS, INFINITY)
+
+_CDS_REDUCE(_cds_sse2_max_i32, _CDS_SSE2, int32_t, __m128i, 4, _mm_set1_epi32, _CDS_SSE2_LOADI, _CDS_SSE2_STOREI, _cds_sse2_max32, _CDS_GREATER, INT32_MIN)
+_CDS_REDUCE(_cds_sse2_max_f32, _CDS_SSE2, float, __m128, 4, _mm_set1_ps, _mm_loadu_ps, _mm_storeu_ps, _mm_max_ps, _CDS_GREATER, -INFINITY)
+_CDS_REDUCE(_cds_sse2_max_f64, _CDS_SSE2, double, __m128d, 2, _mm_set1_pd, _mm_loadu_pd, _mm_storeu_pd, _mm_max_pd, _CDS_GREATER, -INFINITY)
+
+_CDS_SUM(_cds_sse2_sum_i32, _CDS_SSE2, int32_t, int64_t, __m128i, 4, 2, _mm_setzero_si128, _CDS_SSE2_LOADI, _cds_sse2_add32, _CDS_SSE2_STOREI)
+_CDS_SUM(_cds_sse2_sum_i64, _CDS_SSE2, int64_t, int64_t, __m128i, 2, 2, _mm_setzero_si128, _CDS_SSE2_LOADI, _mm_add_epi64, _CDS_SSE2_STOREI)
+_CDS_SUM(_cds_sse2_sum_f32, _CDS_SSE2, float, double, __m128d, 4, 2, _mm_setzero_pd, _mm_loadu_ps, _CDS_SSE2_ADDPS, _mm_storeu_pd)
+_CDS_SUM(_cds_sse2_sum_f64, _CDS_SSE2, double, double, __m128d, 2, 2, _mm_setzero_pd, _mm_loadu_pd, _mm_add_pd, _mm_storeu_pd)
+
+// 64-bit integer min/max would need a compare per half, scalar is as fast
+static const struct _cds_kernels _cds_kernels_sse2 = {
+    _cds_sse2_find_i32, _cds_sse2_find_i64, _cds_sse2_find_f32, _cds_sse2_find_f64,
+    _cds_sse2_count_i32, _cds_sse2_count_i64, _cds_sse2_count_f32, _cds_sse2_count_f64,
+    _cds_sse2_min_i32, _cds_min_i64, _cds_sse2_min_f32, _cds_sse2_min_f64,
+    _cds_sse2_max_i32, _cds_max_i64, _cds_sse2_max_f32, _cds_sse2_max_f64,
+    _cds_sse2_sum_i32, _cds_sse2_sum_i64, _cds_sse2_sum_f32, _cds_sse2_sum_f64
+};
+
+// AVX2, 256 bits
+#define _CDS_AVX2 __attribute__((target("avx2")))
+#define _CDS_AVX2_LOADI(ptr) _mm256_loadu_si256((const __m256i*) (ptr))
+#define _CDS_AVX2_STOREI(ptr, value) _mm256_storeu_si256((__m256i*) (ptr), value)
+#define _CDS_AVX2_EQ32(a, b) ((unsigned int) _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))))
+#define _CDS_AVX2_EQ64(a, b) ((unsigned int) _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b))))
+#define _CDS_AVX2_EQPS(a, b) ((unsigned int) _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)))
+#define _CDS_AVX2_EQPD(a, b) ((unsigned int) _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)))
+#define _CDS_AVX2_MIN64(a, b) _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b))
+#define _CDS_AVX2_MAX64(a, b) _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(b, a))
+#define _CDS_AVX2_ADD32(a, acc) _mm256_add_epi64(_mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(a))), _mm256_cvtepi32_epi64(_mm256_extracti128_si256(a, 1)))
+#define _CDS_AVX2_ADDPS(a, acc) _mm256_add_pd(_mm256_add_pd(acc, _mm256_cvtps_pd(_mm256_castps256_ps128(a))), _mm256_cvtps_pd(_mm256_extractf128_ps(a, 1)))
+
+_CDS_FIND(_cds_avx2_find_i32, _CDS_AVX2, int32_t, __m256i, 8, _mm256_set1_epi32, _CDS_AVX2_LOADI, _CDS_AVX2_EQ32)
+_CDS_FIND(_cds_avx2_find_i64, _CDS_AVX2, int64_t, __m256i, 4, _mm256_set1_epi64x, _CDS_AVX2_LOADI, _CDS_AVX2_EQ64)
+_CDS_FIND(_cds_avx2_find_f32, _CDS_AVX2, float, __m256, 8, _mm256_set1_ps, _mm256_loadu_ps, _CDS_AVX2_EQPS)
+_CDS_FIND(_cds_avx2_find_f64, _CDS_AVX2, double, __m256d, 4, _mm256_set1_pd, _mm256_loadu_pd, _CDS_AVX2_EQPD)
+
+_CDS_COUNT(_cds_avx2_count_i32, _CDS_AVX2, int32_t, __m256i, 8, _mm256_set1_epi32, _CDS_AVX2_LOADI, _CDS_AVX2_EQ32)
+_CDS_COUNT(_cds_avx2_count_i64, _CDS_AVX2, int64_t, __m256i, 4, _mm256_set1_epi64x, _CDS_AVX2_LOADI, _CDS_AVX2_EQ64)
+_CDS_COUNT(_cds_avx2_count_f32, _CDS_AVX2, float, __m256, 8, _mm256_set1_ps, _mm256_loadu_ps, _CDS_AVX2_EQPS)
+_CDS_COUNT(_cds_avx2_count_f64, _CDS_AVX2, double, __m256d, 4, _mm256_set1_pd, _mm256_loadu_pd, _CDS_AVX2_EQPD)
+
+_CDS_REDUCE(_cds_avx2_min_i32, _CDS_AVX2, int32_t, __m256i, 8, _mm256_set1_epi32, _CDS_AVX2_LOADI, _CDS_AVX2_STOREI, _mm256_min_epi32, _CDS_LESS, INT32_MAX)
+_CDS_REDUCE(_cds_avx2_min_i64, _CDS_AVX2, int64_t, __m256i, 4, _mm256_set1_epi64x, _CDS_AVX2_LOADI, _CDS_AVX2_STOREI, _CDS_AVX2_MIN64, _CDS_LESS, INT64_MAX)
+_CDS_REDUCE(_cds_avx2_min_f32, _CDS_AVX2, float, __m256, 8, _mm256_set1_ps, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_min_ps, _CDS_LESS, INFINITY)
+_CDS_REDUCE(_cds_avx2_min_f64, _CDS_AVX2, double, __m256d, 4, _mm256_set1_pd, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_min_pd, _CDS_LESS, INFINITY)
+
+_CDS_REDUCE(_cds_avx2_max_i32, _CDS_AVX2, int32_t, __m256i, 8, _mm256_set1_epi32, _CDS_AVX2_LOADI, _CDS_AVX2_STOREI, _mm256_max_epi32, _CDS_GREATER, INT32_MIN)
+_CDS_REDUCE(_cds_avx2_max_i64, _CDS_AVX2, int64_t, __m256i, 4, _mm256_set1_epi64x, _CDS_AVX2_LOADI, _CDS_AVX2_STOREI, _CDS_AVX2_MAX64, _CDS_GREATER, INT64_MIN)
+_CDS_REDUCE(_cds_avx2_max_f32, _CDS_AVX2, float, __m256, 8, _mm256_set1_ps, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_max_ps, _CDS_GREATER, -INFINITY)
+_CDS_REDUCE(_cds_avx2_max_f64, _CDS_AVX2, double, __m256d, 4, _mm256_set1_pd, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_max_pd, _CDS_GREATER, -INFINITY)
+
+_CDS_SUM(_cds_avx2_sum_i32, _CDS_AVX2, int32_t, int64_t, __m256i, 8, 4, _mm256_setzero_si256, _CDS_AVX2_LOADI, _CDS_AVX2_ADD32, _CDS_AVX2_STOREI)
+_CDS_SUM(_cds_avx2_sum_i64, _CDS_AVX2, int64_t, int64_t, __m256i, 4, 4, _mm256_setzero_si256, _CDS_AVX2_LOADI, _mm256_add_epi64, _CDS_AVX2_STOREI)
+_CDS_SUM(_cds_avx2_sum_f32, _CDS_AVX2, float, double, __m256d, 8, 4, _mm256_setzero_pd, _mm256_loadu_ps, _CDS_AVX2_ADDPS, _mm256_storeu_pd)
+_CDS_SUM(_cds_avx2_sum_f64, _CDS_AVX2, double, double, __m256d, 4, 4, _mm256_setzero_pd, _mm256_loadu_pd, _mm256_add_pd, _mm256_storeu_pd)
+
+static const struct _cds_kernels _cds_kernels_avx2 = {
+    _cds_avx2_find_i32, _cds_avx2_find_i64, _cds_avx2_find_f32, _cds_avx2_find_f64,
+    _cds_avx2_count_i32, _cds_avx2_count_i64, _cds_avx2_count_f32, _cds_avx2_count_f64,
+    _cds_avx2_min_i32, _cds_avx2_min_i64, _cds_avx2_min_f32, _cds_avx2_min_f64,
+    _cds_avx2_max_i32, _cds_avx2_max_i64, _cds_avx2_max_f32, _cds_avx2_max_f64,
+    _cds_avx2_sum_i32, _cds_avx2_sum_i64, _cds_avx2_sum_f32, _cds_avx2_sum_f64
+};
+
+// AVX-512 foundation, 512 bits
+#define _CDS_AVX512 __attribute__((target("avx512f")))
+#define _CDS_AVX512_LOADI(ptr) _mm512_loadu_si512((const void*) (ptr))
+#define _CDS_AVX512_STOREI(ptr, value) _mm512_storeu_si512((void*) (ptr), value)
+#define _CDS_AVX512_EQ32(a, b) ((unsigned int) _mm512_cmpeq_epi32_mask(a, b))
+#define _CDS_AVX512_EQ64(a, b) ((unsigned int) _mm512_cmpeq_epi64_mask(a, b))
+#define _CDS_AVX512_EQPS(a, b) ((unsigned int) _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ))
+#define _CDS_AVX512_EQPD(a, b) ((unsigned int) _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ))
+#define _CDS_AVX512_ADD32(a, acc) _mm512_add_epi64(_mm512_add_epi64(acc, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(a))), _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(a, 1)))
+#define _CDS_AVX512_ADDPS(a, acc) _mm512_add_pd(_mm512_add_pd(acc, _mm512_cvtps_pd(_mm512_castps512_ps256(a))), _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(a), 1))))
+
+_CDS_FIND(_cds_avx512_find_i32, _CDS_AVX512, int32_t, __m512i, 16, _mm512_set1_epi32, _CDS_AVX512_LOADI, _CDS_AVX512_EQ32)
+_CDS_FIND(_cds_avx512_find_i64, _CDS_AVX512, int64_t, __m512i, 8, _mm512_set1_epi64, _CDS_AVX512_LOADI, _CDS_AVX512_EQ64)
+_CDS_FIND(_cds_avx512_find_f32, _CDS_AVX512, float, __m512, 16, _mm512_set1_ps, _mm512_loadu_ps, _CDS_AVX512_EQPS)
+_CDS_FIND(_cds_avx512_find_f64, _CDS_AVX512, double, __m512d, 8, _mm512_set1_pd, _mm512_loadu_pd, _CDS_AVX512_EQPD)
+
+_CDS_COUNT(_cds_avx512_count_i32, _CDS_AVX512, int32_t, __m512i, 16, _mm512_set1_epi32, _CDS_AVX512_LOADI, _CDS_AVX512_EQ32)
+_CDS_COUNT(_cds_avx512_count_i64, _CDS_AVX512, int64_t, __m512i, 8, _mm512_set1_epi64, _CDS_AVX512_LOADI, _CDS_AVX512_EQ64)
+_CDS_COUNT(_cds_avx512_count_f32, _CDS_AVX512, float, __m512, 16, _mm512_set1_ps, _mm512_loadu_ps, _CDS_AVX512_EQPS)
+_CDS_COUNT(_cds_avx512_count_f64, _CDS_AVX512, double, __m512d, 8, _mm512_set1_pd, _mm512_loadu_pd, _CDS_AVX512_EQPD)
+
+_CDS_REDUCE(_cds_avx512_min_i32, _CDS_AVX512, int32_t, __m512i, 16, _mm512_set1_epi32, _CDS_AVX512_LOADI, _CDS_AVX512_STOREI, _mm512_min_epi32, _CDS_LESS, INT32_MAX)
+_CDS_REDUCE(_cds_avx512_min_i64, _CDS_AVX512, int64_t, __m512i, 8, _mm512_set1_epi64, _CDS_AVX512_LOADI, _CDS_AVX512_STOREI, _mm512_min_epi64, _CDS_LESS, INT64_MAX)
+_CDS_REDUCE(_cds_avx512_min_f32, _CDS_AVX512, float, __m512, 16, _mm512_set1_ps, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_min_ps, _CDS_LESS, INFINITY)
+_CDS_REDUCE(_cds_avx512_min_f64, _CDS_AVX512, double, __m512d, 8, _mm512_set1_pd, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_min_pd, _CDS_LESS, INFINITY)
+
+_CDS_REDUCE(_cds_avx512_max_i32, _CDS_AVX512, int32_t, __m512i, 16, _mm512_set1_epi32, _CDS_AVX512_LOADI, _CDS_AVX512_STOREI, _mm512_max_epi32, _CDS_GREATER, INT32_MIN)
+_CDS_REDUCE(_cds_avx512_max_i64, _CDS_AVX512, int64_t, __m512i, 8, _mm512_set1_epi64, _CDS_AVX512_LOADI, _CDS_AVX512_STOREI, _mm512_max_epi64, _CDS_GREATER, INT64_MIN)
+_CDS_REDUCE(_cds_avx512_max_f32, _CDS_AVX512, float, __m512, 16, _mm512_set1_ps, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_max_ps, _CDS_GREATER, -INFINITY)
+_CDS_REDUCE(_cds_avx512_max_f64, _CDS_AVX512, double, __m512d, 8, _mm512_set1_pd, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_max_pd, _CDS_GREATER, -INFINITY)
+
+_CDS_SUM(_cds_avx512_sum_i32, _CDS_AVX512, int32_t, int64_t, __m512i, 16, 8, _mm512_setzero_si512, _CDS_AVX512_LOADI, _CDS_AVX512_ADD32, _CDS_AVX512_STOREI)
+_CDS_SUM(_cds_avx512_sum_i64, _CDS_AVX512, int64_t, int64_t, __m512i, 8, 8, _mm512_setzero_si512, _CDS_AVX512_LOADI, _mm512_add_epi64, _CDS_AVX512_STOREI)
+_CDS_SUM(_cds_avx512_sum_f32, _CDS_AVX512, float, double, __m512d, 16, 8, _mm512_setzero_pd, _mm512_loadu_ps, _CDS_AVX512_ADDPS, _mm512_storeu_pd)
+_CDS_SUM(_cds_avx512_sum_f64, _CDS_AVX512, double, double, __m512d, 8, 8, _mm512_setzero_pd, _mm512_loadu_pd, _mm512_add_pd, _mm512_storeu_pd)
+
+static const struct _cds_kernels _cds_kernels_avx512 = {
+    _cds_avx512_find_i32, _cds_avx512_find_i64, _cds_avx512_find_f32, _cds_avx512_find_f64,
+    _cds_avx512_count_i32, _cds_avx512_count_i64, _cds_avx512_count_f32, _cds_avx512_count_f64,
+    _cds_avx512_min_i32, _cds_avx512_min_i64, _cds_avx512_min_f32, _cds_avx512_min_f64,
+    _cds_avx512_max_i32, _cds_avx512_max_i64, _cds_avx512_max_f32, _cds_avx512_max_f64,
+    _cds_avx512_sum_i32, _cds_avx512_sum_i64, _cds_avx512_sum_f32, _cds_avx512_sum_f64
+};
+#endif
+
+size_t cds_vector_find_i32(CDS_VECTOR(int32_t) vector, int32_t value) {
+    if (vector == NULL || vector->type != sizeof(int32_t)) {
+        return CDS_VECTOR_NPOS;
+    }
+
+    return _cds_kernels()->find_i32((const int32_t*) vector->data, vector->size, value);
+}
+
+size_t cds_vector_find_i64(CDS_VECTOR(int64_t) vector, int64_t value) {
+    if (vector == NULL || vector->type != sizeof(int64_t)) {
+        return CDS_VECTOR_NPOS;
+    }
+
+    return _cds_kernels()->find_i64((const int64_t*) vector->data, vector->size, value);
+}
+
+size_t cds_vector_find_f32(CDS_VECTOR(float) vector, float value) {
+    if (vector == NULL || vector->type != sizeof(float)) {
+        return CDS_VECTOR_NPOS;
+    }
+
+    return _cds_kernels()->find_f32((const float*) vector->data, vector->size, value);
+}
+
+size_t cds_vector_find_f64(CDS_VECTOR(double) vector, double value) {
+    if (vector == NULL || vector->type != sizeof(double)) {
+        return CDS_VECTOR_NPOS;
+    }
+
+    return _cds_kernels()->find_f64((const double*) vector->data, vector->size, value);
+}
+
+size_t cds_vector_count_i32(CDS_VECTOR(int32_t) vector, int32_t value) {
+    if (vector == NULL || vector->type != sizeof(int32_t)) {
+        return 0;
+    }
+
+    return _cds_kernels()->count_i32((const int32_t*) vector->data, vector->size, value);
+}
+
+size_t cds_vector_count_i64(CDS_VECTOR(int64_t) vector, int64_t value) {
+    if (vector == NULL || vector->type != sizeof(int64_t)) {
+        return 0;
+    }
+
+    return _cds_kernels()->count_i64((const int64_t*) vector->data, vector->size, value);
+}
+
+size_t cds_vector_count_f32(CDS_VECTOR(float) vector, float value) {
+    if (vector == NULL || vector->type != sizeof(float)) {
+        return 0;
+    }
+
+    return _cds_kernels()->count_f32((const float*) vector->data, vector->size, value);
+}
+
+size_t cds_vector_count_f64(CDS_VECTOR(double) vector, double value) {
+    if (vector == NULL || vector->type != sizeof(double)) {
+        return 0;
+    }
+
+    return _cds_kernels()->count_f64((const double*) vector->data, vector->size, value);
+}
+
+int cds_vector_min_i32(CDS_VECTOR(int32_t) vector, int32_t* out) {
+    if (vector == NULL || vector->type != sizeof(int32_t) || vector->size == 0 || out == NULL) {
+        return CDS_ERR;
+    }
+
+    *out = _cds_kernels()->min_i32((const int32_t*) vector->data, vector->size);
+    return CDS_OK;
+}
+
+int cds_vector_min_i64(CDS_VECTOR(int64_t) vector, int64_t* out) {
+    if (vector == NULL || vector->type != sizeof(int64_t) || vector->size == 0 || out == NULL) {
+        return CDS_ERR;
+    }
+
+    *out = _cds_kernels()->min_i64((const int64_t*) vector->data, vector->size);
+    return CDS_OK;
+}
+
+int cds_vector_min_f32(CDS_VECTOR(float) vector, float* out) {
+    if (vector == NULL || vector->type != sizeof(float) || vector->size == 0 || out == NULL) {
+        return CDS_ERR;
+    }
+
+    *out = _cds_kernels()->min_f32((const float*) vector->data, vector->size);
+    return CDS_OK;
+}
+
+int cds_vector_min_f64(CDS_VECTOR(double) vector, double* out) {
+    if (vector == NULL || vector->type != sizeof(double) || vector->size == 0 || out == NULL) {
+        return CDS_ERR;
+    }
+
+    *out = _cds_kernels()->min_f64((const double*) vector->data, vector->size);
+    return CDS_OK;
+}
+
+int cds_vector_max_i32(CDS_VECTOR(int32_t) vector, int32_t* out) {
+    if (vector == NULL || vector->type != sizeof(int32_t) || vector->size == 0 || out == NULL) {
+        return CDS_ERR;
+    }
+
+    *out = _cds_kernels()->max_i32((const int32_t*) vector->data, vector->size);
+    return CDS_OK;
+}
+
+int cds_vector_max_i64(CDS_VECTOR(int64_t) vector, int64_t* out) {
+    if (vector == NULL || vector->type != sizeof(int64_t) || vector->size == 0 || out == NULL) {
+        return CDS_ERR;
+    }
+
+    *out = _cds_kernels()->max_i64((const int64_t*) vector->data, vector->size);
+    return CDS_OK;
+}
+
+int cds_vector_max_f32(CDS_VECTOR(float) vector, float* out) {
+    if (vector == NULL || vector->type != sizeof(float) || vector->size == 0 || out == NULL) {
+        return CDS_ERR;
+    }
+
+    *out = _cds_kernels()->max_f32((const float*) vector->data, vector->size);
+    return CDS_OK;
+}
+
+int cds_vector_max_f64(CDS_VECTOR(double) vector, double* out) {
+    if (vector == NULL || vector->type != sizeof(double) || vector->size == 0 || out == NULL) {
+        return CDS_ERR;
+    }
+
+    *out = _cds_kernels()->max_f64((const double*) vector->data, vector->size);
+    return CDS_OK;
+}
+
+int cds_vector_sum_i32(CDS_VECTOR(int32_t) vector, int64_t* out) {
+    if (vector == NULL || vector->type != sizeof(int32_t) || out == NULL) {
+        return CDS_ERR;
+    }
+
+    *out = _cds_kernels()->sum_i32((const int32_t*) vector->data, vector->size);
+    return CDS_OK;
+}
+
+int cds_vector_sum_i64(CDS_VECTOR(int64_t) vector, int64_t* out) {
+    if (vector == NULL || vector->type != sizeof(int64_t) || out == NULL) {
+        return CDS_ERR;
+    }
+
+    *out = _cds_kernels()->sum_i64((const int64_t*) vector->data, vector->size);
+    return CDS_OK;
+}
+
+int cds_vector_sum_f32(CDS_VECTOR(float) vector, double* out) {
+    if (vector == NULL || vector->type != sizeof(float) || out == NULL) {
+        return CDS_ERR;
+    }
+
+    *out = _cds_kernels()->sum_f32((const float*) vector->data, vector->size);
+    return CDS_OK;
+}
+
+int cds_vector_sum_f64(CDS_VECTOR(double) vector, double* out) {
+    if (vector == NULL || vector->type != sizeof(double) || out == NULL) {
+        return CDS_ERR;
+    }
+
+    *out = _cds_kernels()->sum_f64((const double*) vector->data, vector->size);
+    return CDS_OK;
+}
+
+const struct _cds_kernels* _cds_kernels_tier(enum _cds_kernel_tier tier) {
+    switch (tier) {
+#ifdef _CDS_X86
+        // cpu features are read once by libgcc at startup, this is a load
+        case _CDS_KERNELS_AVX512:
+            return __builtin_cpu_supports("avx512f") ? &_cds_kernels_avx512 : NULL;
+        case _CDS_KERNELS_AVX2:
+            return __builtin_cpu_supports("avx2") ? &_cds_kernels_avx2 : NULL;
+        case _CDS_KERNELS_SSE2:
+            return &_cds_kernels_sse2;
+#endif
+        case _CDS_KERNELS_SCALAR:
+            return &_cds_kernels_scalar;
+        default:
+            return NULL;
+    }
+}
+
+static const struct _cds_kernels* _cds_kernels() {
+    // widest tier first, scalar one ends the search
+    for (int tier = 0; tier < _CDS_KERNELS_TIERS; tier++) {
+        const struct _cds_kernels* kernels = _cds_kernels_tier((enum _cds_kernel_tier) tier);
+        if (kernels != NULL) {
+            return kernels;
+        }
+    }
+
+    return &_cds_kernels_scalar;
+}
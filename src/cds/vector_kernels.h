@@ -0,0 +1,57 @@
+#ifndef CDS_VECTOR_KERNELS_GUARD_HEADER
+#define CDS_VECTOR_KERNELS_GUARD_HEADER
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Search and reduction kernels of primitive vectors, not part of the public
+ * API.
+ *
+ * Every instruction set has its own table, public functions go through the
+ * widest one the CPU supports.
+ */
+
+// kernels for a primitive type, data is contiguous and size can be 0
+struct _cds_kernels {
+    size_t (*find_i32)(const int32_t* data, size_t size, int32_t value);
+    size_t (*find_i64)(const int64_t* data, size_t size, int64_t value);
+    size_t (*find_f32)(const float* data, size_t size, float value);
+    size_t (*find_f64)(const double* data, size_t size, double value);
+
+    size_t (*count_i32)(const int32_t* data, size_t size, int32_t value);
+    size_t (*count_i64)(const int64_t* data, size_t size, int64_t value);
+    size_t (*count_f32)(const float* data, size_t size, float value);
+    size_t (*count_f64)(const double* data, size_t size, double value);
+
+    int32_t (*min_i32)(const int32_t* data, size_t size);
+    int64_t (*min_i64)(const int64_t* data, size_t size);
+    float (*min_f32)(const float* data, size_t size);
+    double (*min_f64)(const double* data, size_t size);
+
+    int32_t (*max_i32)(const int32_t* data, size_t size);
+    int64_t (*max_i64)(const int64_t* data, size_t size);
+    float (*max_f32)(const float* data, size_t size);
+    double (*max_f64)(const double* data, size_t size);
+
+    int64_t (*sum_i32)(const int32_t* data, size_t size);
+    int64_t (*sum_i64)(const int64_t* data, size_t size);
+    double (*sum_f32)(const float* data, size_t size);
+    double (*sum_f64)(const double* data, size_t size);
+};
+
+// tables from widest to narrowest, scalar one is always available
+enum _cds_kernel_tier {
+    _CDS_KERNELS_AVX512,
+    _CDS_KERNELS_AVX2,
+    _CDS_KERNELS_SSE2,
+    _CDS_KERNELS_SCALAR,
+    _CDS_KERNELS_TIERS
+};
+
+/**
+ * Give back kernels of a tier, NULL if CPU or compiler lacks it.
+ */
+const struct _cds_kernels* _cds_kernels_tier(enum _cds_kernel_tier tier);
+
+#endif // CDS_VECTOR_KERNELS_GUARD_HEADER
@@ -0,0 +1,342 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/vector.h>
+
+#include "pool.h"
+
+// below it a single qsort beats spawning threads
+#define _CDS_SORT_PARALLEL 16384
+#define _CDS_RADIX_BITS 8
+#define _CDS_RADIX_BUCKETS (1 << _CDS_RADIX_BITS)
+
+struct _cds_sort_job {
+    uint8_t* src;
+    uint8_t* dst;
+    size_t size;
+    size_t type;
+    int (*cmp)(const void*, const void*);
+
+    // sorted runs and how many elements each one covers
+    size_t runs;
+    size_t width;
+};
+
+struct _cds_radix_job {
+    uint8_t* src;
+    uint8_t* dst;
+    size_t size;
+    size_t type;
+
+    enum cds_vector_key key;
+    size_t offset;
+    unsigned int shift;
+
+    // per worker histogram, turned into per worker offsets
+    size_t (*counts)[_CDS_RADIX_BUCKETS];
+};
+
+static void _cds_sort_runs(void* context, size_t index, size_t count);
+static void _cds_sort_merge(void* context, size_t index, size_t count);
+static void _cds_merge(struct _cds_sort_job* job, size_t begin, size_t middle, size_t end);
+static void _cds_run_bounds(struct _cds_sort_job* job, size_t run, size_t* begin, size_t* end);
+
+static void _cds_radix_count(void* context, size_t index, size_t count);
+static void _cds_radix_scatter(void* context, size_t index, size_t count);
+static uint64_t _cds_radix_key(const uint8_t* element, enum cds_vector_key key, size_t offset);
+static size_t _cds_radix_width(enum cds_vector_key key);
+
+static inline void _cds_copy(uint8_t* dst, const uint8_t* src, size_t type) {
+    // common element sizes become a single move
+    switch (type) {
+        case 4: memcpy(dst, src, 4); break;
+        case 8: memcpy(dst, src, 8); break;
+        case 16: memcpy(dst, src, 16); break;
+        default: memcpy(dst, src, type); break;
+    }
+}
+
+int cds_vector_sort(CDS_VECTOR(T) vector, int (*cmp)(const void*, const void*)) {
+    return cds_vector_sort_parallel(vector, cmp, 0);
+}
+
+int cds_vector_sort_parallel(CDS_VECTOR(T) vector, int (*cmp)(const void*, const void*), size_t nthreads) {
+    if (vector == NULL || cmp == NULL || cds_vector_readonly(vector)) {
+        return CDS_ERR;
+    }
+
+    size_t threads = _cds_pool_threads(nthreads);
+    if (threads == 1 || vector->size < _CDS_SORT_PARALLEL) {
+        qsort(vector->data, vector->size, vector->type, cmp);
+        vector->mod++;
+
+        return CDS_OK;
+    }
+
+    struct cds_memory* memory = &vector->memory;
+    uint8_t* buffer = memory->allocator(memory->context, vector->type * vector->size);
+    if (buffer == NULL) {
+        return CDS_ERR;
+    }
+
+    _cds_pool pool = _cds_pool_create(threads);
+    if (pool == NULL) {
+        memory->deallocator(memory->context, buffer);
+        return CDS_ERR;
+    }
+
+    struct _cds_sort_job job = {
+        .src = vector->data,
+        .dst = buffer,
+        .size = vector->size,
+        .type = vector->type,
+        .cmp = cmp,
+        .runs = _cds_pool_size(pool),
+        .width = 1
+    };
+
+    // every worker sorts its own run, then runs are merged pairwise
+    _cds_pool_run(pool, _cds_sort_runs, &job);
+
+    while (job.width < job.runs) {
+        _cds_pool_run(pool, _cds_sort_merge, &job);
+
+        uint8_t* swap = job.src;
+        job.src = job.dst;
+        job.dst = swap;
+        job.width *= 2;
+    }
+
+    if (job.src != vector->data) {
+        memcpy(vector->data, job.src, vector->type * vector->size);
+    }
+
+    _cds_pool_destroy(pool);
+    memory->deallocator(memory->context, buffer);
+    vector->mod++;
+
+    return CDS_OK;
+}
+
+int cds_vector_radix_sort(CDS_VECTOR(T) vector, enum cds_vector_key key, size_t offset, size_t nthreads) {
+    size_t width = _cds_radix_width(key);
+    if (vector == NULL || width == 0 || cds_vector_readonly(vector) || offset > vector->type || vector->type - offset < width) {
+        return CDS_ERR;
+    }
+
+    if (vector->size < 2) {
+        return CDS_OK;
+    }
+
+    size_t threads = _cds_pool_threads(nthreads);
+    if (vector->size < _CDS_SORT_PARALLEL) {
+        threads = 1;
+    }
+
+    struct cds_memory* memory = &vector->memory;
+    uint8_t* buffer = memory->allocator(memory->context, vector->type * vector->size);
+    if (buffer == NULL) {
+        return CDS_ERR;
+    }
+
+    _cds_pool pool = _cds_pool_create(threads);
+    size_t (*counts)[_CDS_RADIX_BUCKETS] = malloc(sizeof(size_t[_CDS_RADIX_BUCKETS]) * _cds_pool_size(pool));
+
+    if (pool == NULL || counts == NULL) {
+        _cds_pool_destroy(pool);
+        free(counts);
+        memory->deallocator(memory->context, buffer);
+        return CDS_ERR;
+    }
+
+    struct _cds_radix_job job = {
+        .src = vector->data,
+        .dst = buffer,
+        .size = vector->size,
+        .type = vector->type,
+        .key = key,
+        .offset = offset,
+        .counts = counts
+    };
+    size_t workers = _cds_pool_size(pool);
+
+    for (job.shift = 0; job.shift < width * 8; job.shift += _CDS_RADIX_BITS) {
+        _cds_pool_run(pool, _cds_radix_count, &job);
+
+        // skip digits where every key falls in the same bucket
+        bool trivial = false;
+        for (size_t bucket = 0; bucket < _CDS_RADIX_BUCKETS && !trivial; bucket++) {
+            size_t total = 0;
+            for (size_t worker = 0; worker < workers; worker++) {
+                total += counts[worker][bucket];
+            }
+            trivial = total == job.size;
+        }
+        if (trivial) {
+            continue;
+        }
+
+        // exclusive prefix sum, bucket major and worker minor keeps it stable
+        size_t position = 0;
+        for (size_t bucket = 0; bucket < _CDS_RADIX_BUCKETS; bucket++) {
+            for (size_t worker = 0; worker < workers; worker++) {
+                size_t count = counts[worker][bucket];
+                counts[worker][bucket] = position;
+                position += count;
+            }
+        }
+
+        _cds_pool_run(pool, _cds_radix_scatter, &job);
+
+        uint8_t* swap = job.src;
+        job.src = job.dst;
+        job.dst = swap;
+    }
+
+    if (job.src != vector->data) {
+        memcpy(vector->data, job.src, vector->type * vector->size);
+    }
+
+    free(counts);
+    _cds_pool_destroy(pool);
+    memory->deallocator(memory->context, buffer);
+    vector->mod++;
+
+    return CDS_OK;
+}
+
+static void _cds_sort_runs(void* context, size_t index, size_t count) {
+    (void) count;
+
+    struct _cds_sort_job* job = context;
+
+    size_t begin, end;
+    _cds_run_bounds(job, index, &begin, &end);
+
+    qsort(&job->src[job->type * begin], end - begin, job->type, job->cmp);
+}
+
+static void _cds_sort_merge(void* context, size_t index, size_t count) {
+    struct _cds_sort_job* job = context;
+
+    // pairs of runs are spread between workers
+    for (size_t run = index * 2 * job->width; run < job->runs; run += count * 2 * job->width) {
+        size_t begin, middle, end, unused;
+
+        _cds_run_bounds(job, run, &begin, &unused);
+        if (run + job->width < job->runs) {
+            _cds_run_bounds(job, run + job->width, &middle, &unused);
+        } else {
+            middle = job->size;
+        }
+        if (run + 2 * job->width < job->runs) {
+            _cds_run_bounds(job, run + 2 * job->width, &end, &unused);
+        } else {
+            end = job->size;
+        }
+
+        _cds_merge(job, begin, middle, end);
+    }
+}
+
+static void _cds_merge(struct _cds_sort_job* job, size_t begin, size_t middle, size_t end) {
+    size_t type = job->type;
+    uint8_t* left = &job->src[type * begin];
+    uint8_t* left_end = &job->src[type * middle];
+    uint8_t* right = left_end;
+    uint8_t* right_end = &job->src[type * end];
+    uint8_t* out = &job->dst[type * begin];
+
+    while (left < left_end && right < right_end) {
+        if (job->cmp(right, left) < 0) {
+            _cds_copy(out, right, type);
+            right += type;
+        } else {
+            _cds_copy(out, left, type);
+            left += type;
+        }
+        out += type;
+    }
+
+    memcpy(out, left, left_end - left);
+    out += left_end - left;
+    memcpy(out, right, right_end - right);
+}
+
+static void _cds_run_bounds(struct _cds_sort_job* job, size_t run, size_t* begin, size_t* end) {
+    _cds_pool_split(job->size, run, job->runs, begin, end);
+}
+
+static void _cds_radix_count(void* context, size_t index, size_t count) {
+    struct _cds_radix_job* job = context;
+    size_t* histogram = job->counts[index];
+
+    size_t begin, end;
+    _cds_pool_split(job->size, index, count, &begin, &end);
+
+    memset(histogram, 0, sizeof(size_t[_CDS_RADIX_BUCKETS]));
+    for (size_t i = begin; i < end; i++) {
+        uint64_t key = _cds_radix_key(&job->src[job->type * i], job->key, job->offset);
+        histogram[(key >> job->shift) & (_CDS_RADIX_BUCKETS - 1)]++;
+    }
+}
+
+static void _cds_radix_scatter(void* context, size_t index, size_t count) {
+    struct _cds_radix_job* job = context;
+    size_t* positions = job->counts[index];
+
+    size_t begin, end;
+    _cds_pool_split(job->size, index, count, &begin, &end);
+
+    for (size_t i = begin; i < end; i++) {
+        uint8_t* element = &job->src[job->type * i];
+        uint64_t key = _cds_radix_key(element, job->key, job->offset);
+        size_t position = positions[(key >> job->shift) & (_CDS_RADIX_BUCKETS - 1)]++;
+
+        _cds_copy(&job->dst[job->type * position], element, job->type);
+    }
+}
+
+static uint64_t _cds_radix_key(const uint8_t* element, enum cds_vector_key key, size_t offset) {
+    uint32_t u32;
+    uint64_t u64;
+
+    // map keys to unsigned integers keeping their order
+    switch (key) {
+        case CDS_VECTOR_KEY_U32:
+            memcpy(&u32, &element[offset], sizeof(uint32_t));
+            return u32;
+        case CDS_VECTOR_KEY_I32:
+            memcpy(&u32, &element[offset], sizeof(uint32_t));
+            return u32 ^ UINT32_C(0x80000000);
+        case CDS_VECTOR_KEY_F32:
+            memcpy(&u32, &element[offset], sizeof(uint32_t));
+            return u32 & UINT32_C(0x80000000) ? ~u32 : u32 | UINT32_C(0x80000000);
+        case CDS_VECTOR_KEY_U64:
+            memcpy(&u64, &element[offset], sizeof(uint64_t));
+            return u64;
+        case CDS_VECTOR_KEY_I64:
+            memcpy(&u64, &element[offset], sizeof(uint64_t));
+            return u64 ^ UINT64_C(0x8000000000000000);
+        case CDS_VECTOR_KEY_F64:
+            memcpy(&u64, &element[offset], sizeof(uint64_t));
+            return u64 & UINT64_C(0x8000000000000000) ? ~u64 : u64 | UINT64_C(0x8000000000000000);
+    }
+
+    return 0;
+}
+
+static size_t _cds_radix_width(enum cds_vector_key key) {
+    switch (key) {
+        case CDS_VECTOR_KEY_U32:
+        case CDS_VECTOR_KEY_I32:
+        case CDS_VECTOR_KEY_F32:
+            return sizeof(uint32_t);
+        case CDS_VECTOR_KEY_U64:
+        case CDS_VECTOR_KEY_I64:
+        case CDS_VECTOR_KEY_F64:
+            return sizeof(uint64_t);
+    }
+
+    return 0;
+}
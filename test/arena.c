@@ -0,0 +1,112 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/arena.h>
+
+// chunks taken from system memory, counted
+static size_t chunks = 0;
+
+static void* counting_alloc(void* context, size_t bytes) {
+    (void) context;
+    chunks++;
+    return malloc(bytes);
+}
+
+static void* counting_realloc(void* context, void* ptr, size_t bytes) {
+    (void) context;
+    return realloc(ptr, bytes);
+}
+
+static void counting_free(void* context, void* ptr) {
+    (void) context;
+    free(ptr);
+}
+
+int main() {
+    struct cds_memory counting = {
+        .allocator = counting_alloc, .reallocator = counting_realloc, .deallocator = counting_free
+    };
+    cds_arena arena = cds_arena_create(4096, counting);
+    struct cds_memory memory = cds_memory_arena(arena);
+    size_t created = chunks;
+
+    // aligned block moved by realloc stays aligned and keeps its bytes
+    uint8_t* block = memory.aligned_allocator(memory.context, 128, 40);
+    assert(block != NULL && (uintptr_t) block % 128 == 0);
+    memset(block, 7, 40);
+
+    uint8_t* other = memory.allocator(memory.context, 8);
+    assert(other != NULL);
+
+    uint8_t* moved = memory.reallocator(memory.context, block, 1000);
+    assert(moved != NULL && moved != block && (uintptr_t) moved % 128 == 0);
+    for (int i = 0; i < 40; i++) {
+        assert(moved[i] == 7);
+    }
+
+    // last block grows in place, and is released in place
+    uint8_t* grown = memory.reallocator(memory.context, moved, 1200);
+    assert(grown == moved);
+    size_t used = cds_arena_used(arena);
+    memory.deallocator(memory.context, grown);
+    assert(cds_arena_used(arena) < used);
+    assert(memory.allocator(memory.context, 16) == grown);
+
+    // chunks are chained once first one runs out, blocks stay apart
+    cds_arena_reset(arena);
+    struct cds_arena_mark mark = cds_arena_mark(arena);
+    uint8_t* blocks[64];
+    for (int i = 0; i < 64; i++) {
+        blocks[i] = memory.allocator(memory.context, 200);
+        assert(blocks[i] != NULL && (uintptr_t) blocks[i] % _Alignof(max_align_t) == 0);
+        memset(blocks[i], i, 200);
+    }
+    for (int i = 0; i < 64; i++) {
+        assert(blocks[i][0] == i && blocks[i][199] == i);
+    }
+    assert(chunks > created && cds_arena_used(arena) >= 64 * 200);
+
+    // rewind hands out same addresses again, with chunks kept
+    size_t chained = chunks;
+    cds_arena_rewind(arena, mark);
+    assert(cds_arena_used(arena) == 0);
+    for (int i = 0; i < 64; i++) {
+        assert(memory.allocator(memory.context, 200) == blocks[i]);
+    }
+
+    // rewind to a mark in the middle
+    cds_arena_reset(arena);
+    memory.allocator(memory.context, 100);
+    mark = cds_arena_mark(arena);
+    used = cds_arena_used(arena);
+    uint8_t* after = memory.allocator(memory.context, 3000);
+    memory.allocator(memory.context, 3000);
+    cds_arena_rewind(arena, mark);
+    assert(cds_arena_used(arena) == used);
+    assert(memory.allocator(memory.context, 3000) == after);
+
+    // reset reuses every chunk, no allocator is called
+    cds_arena_reset(arena);
+    for (int i = 0; i < 64; i++) {
+        assert(memory.allocator(memory.context, 200) == blocks[i]);
+    }
+    assert(chunks == chained);
+
+    // oversized blocks get a chunk of their own
+    uint8_t* huge = memory.aligned_allocator(memory.context, 256, 20000);
+    assert(huge != NULL && (uintptr_t) huge % 256 == 0 && chunks == chained + 1);
+    memset(huge, 1, 20000);
+    uint8_t* small = memory.allocator(memory.context, 16);
+    assert(small != NULL && (small < huge || small >= huge + 20000));
+
+    assert(memory.aligned_allocator(memory.context, 24, 8) == NULL);
+    assert(memory.allocator(memory.context, SIZE_MAX - 8) == NULL);
+
+    cds_arena_destroy(arena);
+
+    printf("arena: ok\n");
+    return 0;
+}
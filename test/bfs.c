@@ -0,0 +1,90 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/cds.h>
+#include <cds/graph.h>
+
+#include "graph_fixture.h"
+
+// plain queue BFS over edge list, distances only
+static void reference(int nodes, const struct cds_edge* edges, size_t count, unsigned int source, unsigned int* dist) {
+    unsigned int* queue = malloc(sizeof(unsigned int) * nodes);
+    size_t head = 0, tail = 0;
+
+    for (int node = 0; node < nodes; node++) {
+        dist[node] = CDS_GRAPH_UNREACHED;
+    }
+    dist[source] = 0;
+    queue[tail++] = source;
+
+    while (head < tail) {
+        unsigned int node = queue[head++];
+        for (size_t i = 0; i < count; i++) {
+            if (edges[i].from == node && dist[edges[i].to] == CDS_GRAPH_UNREACHED) {
+                dist[edges[i].to] = dist[node] + 1;
+                queue[tail++] = edges[i].to;
+            }
+        }
+    }
+
+    free(queue);
+}
+
+static void check(cds_graph* g, int nodes, const struct cds_edge* edges, size_t count, unsigned int source, size_t nthreads) {
+    unsigned int* expected = malloc(sizeof(unsigned int) * nodes);
+    unsigned int* dist = malloc(sizeof(unsigned int) * nodes);
+    unsigned int* parent = malloc(sizeof(unsigned int) * nodes);
+
+    reference(nodes, edges, count, source, expected);
+    assert(cds_graph_bfs(g, source, dist, parent, nthreads) == CDS_OK);
+
+    for (int node = 0; node < nodes; node++) {
+        assert(dist[node] == expected[node]);
+
+        if (dist[node] == CDS_GRAPH_UNREACHED) {
+            assert(parent[node] == CDS_GRAPH_UNREACHED);
+        } else if ((unsigned int) node == source) {
+            assert(parent[node] == source);
+        } else {
+            // parent is one level up and links to node
+            assert(cds_has_edge(g, parent[node], node));
+            assert(dist[parent[node]] + 1 == dist[node]);
+        }
+    }
+
+    free(expected);
+    free(dist);
+    free(parent);
+}
+
+int main() {
+    // 0 -> 1 -> 2 -> 3, 0 -> 2, 4 unreachable
+    struct cds_edge small[] = {{0, 1}, {1, 2}, {2, 3}, {0, 2}, {4, 0}};
+    cds_graph* g = cds_create_csr_graph(5, small, 5);
+    unsigned int dist[5], parent[5];
+
+    assert(cds_graph_bfs(g, 0, dist, parent, 1) == CDS_OK);
+    assert(dist[0] == 0 && dist[1] == 1 && dist[2] == 1 && dist[3] == 2);
+    assert(dist[4] == CDS_GRAPH_UNREACHED && parent[2] == 0 && parent[3] == 2);
+    assert(cds_graph_bfs(g, 5, dist, parent, 1) == CDS_ERR);
+    cds_destroy_graph(g);
+
+    // random graphs, large enough to run in parallel and switch direction
+    int nodes = 6000;
+    size_t count = 30000;
+    struct cds_edge* edges = fixture_edges(nodes, count, 13);
+    cds_graph* graphs[FIXTURE_BACKENDS];
+    fixture_backends(nodes, edges, count, graphs);
+
+    for (size_t backend = 0; backend < FIXTURE_BACKENDS; backend++) {
+        check(graphs[backend], nodes, edges, count, 0, 1);
+        check(graphs[backend], nodes, edges, count, 17, 4);
+    }
+
+    fixture_destroy(graphs);
+    free(edges);
+
+    printf("bfs: ok\n");
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/dsu.h>
+#include <cds/graph.h>
+
+#include "graph_fixture.h"
+
+// labels of weakly connected components by repeated relaxation to minimum
+static void reference(int nodes, const struct cds_edge* edges, size_t count, unsigned int* label) {
+    for (int node = 0; node < nodes; node++) {
+        label[node] = node;
+    }
+
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t i = 0; i < count; i++) {
+            unsigned int* a = &label[edges[i].from];
+            unsigned int* b = &label[edges[i].to];
+            if (*a != *b) {
+                *a = *b = *a < *b ? *a : *b;
+                changed = true;
+            }
+        }
+    }
+}
+
+static void check(cds_graph* g, int nodes, const unsigned int* expected, size_t nthreads) {
+    unsigned int* labels = malloc(sizeof(unsigned int) * nodes);
+    unsigned int next = 0;
+
+    assert(cds_graph_components(g, labels, nthreads) == CDS_OK);
+
+    // same partition, labels dense in order of lowest node
+    for (int node = 0; node < nodes; node++) {
+        if (expected[node] == (unsigned int) node) {
+            assert(labels[node] == next++);
+        }
+        assert(labels[node] == labels[expected[node]]);
+    }
+
+    free(labels);
+}
+
+int main() {
+    // standalone union-find
+    cds_dsu dsu = cds_dsu_create(6, cds_memory_system());
+    assert(cds_dsu_size(dsu) == 6 && cds_dsu_sets(dsu) == 6);
+    assert(cds_dsu_union(dsu, 0, 1) && cds_dsu_union(dsu, 2, 1));
+    assert(!cds_dsu_union(dsu, 0, 2));
+    assert(cds_dsu_union_concurrent(dsu, 4, 5) && !cds_dsu_union_concurrent(dsu, 5, 4));
+    assert(cds_dsu_same(dsu, 0, 2) && !cds_dsu_same(dsu, 0, 3));
+    assert(cds_dsu_find(dsu, 5) == cds_dsu_find_concurrent(dsu, 4));
+    assert(cds_dsu_sets(dsu) == 3);
+    cds_dsu_destroy(dsu);
+
+    // direction is ignored: {0, 1, 2}, {3}, {4, 5}
+    struct cds_edge small[] = {{1, 0}, {2, 1}, {5, 4}};
+    cds_graph* g = cds_create_csr_graph(6, small, 3);
+    unsigned int labels[6];
+    assert(cds_graph_components(g, labels, 1) == CDS_OK);
+    assert(labels[0] == 0 && labels[1] == 0 && labels[2] == 0);
+    assert(labels[3] == 1 && labels[4] == 2 && labels[5] == 2);
+    cds_destroy_graph(g);
+
+    // sparse random graph with many components, enough edges for threads
+    int nodes = 40000;
+    size_t count = 20000;
+    struct cds_edge* edges = fixture_edges(nodes, count, 18);
+    unsigned int* expected = malloc(sizeof(unsigned int) * nodes);
+    reference(nodes, edges, count, expected);
+
+    cds_graph* graphs[FIXTURE_BACKENDS];
+    fixture_backends(nodes, edges, count, graphs);
+    for (size_t backend = 0; backend < FIXTURE_BACKENDS; backend++) {
+        check(graphs[backend], nodes, expected, 1);
+        check(graphs[backend], nodes, expected, 4);
+    }
+
+    fixture_destroy(graphs);
+    free(edges);
+    free(expected);
+
+    printf("components: ok\n");
+    return 0;
+}
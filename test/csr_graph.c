@@ -0,0 +1,96 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/graph.h>
+
+#define NODES 200
+#define EDGES 3000
+
+// rows hold exactly reference edges, sorted and without repeats
+static void check(cds_graph* g, bool reference[NODES][NODES]) {
+    for (unsigned int from = 0; from < NODES; from++) {
+        size_t count;
+        const unsigned int* row = cds_graph_csr_row(g, from, &count);
+        assert(row != NULL || count == 0);
+        assert(cds_graph_out_degree(g, from) == count);
+
+        size_t expected = 0;
+        for (unsigned int to = 0; to < NODES; to++) {
+            expected += reference[from][to];
+            assert(cds_has_edge(g, from, to) == reference[from][to]);
+        }
+        assert(count == expected);
+
+        for (size_t i = 0; i < count; i++) {
+            assert(row[i] < NODES && reference[from][row[i]]);
+            assert(i == 0 || row[i - 1] < row[i]);
+        }
+    }
+}
+
+int main() {
+    static bool reference[NODES][NODES];
+    struct cds_edge* edges = malloc(sizeof(struct cds_edge) * EDGES);
+    srand(11);
+
+    // repeats, self loops and neighbors around 64-bit word boundaries
+    for (size_t i = 0; i < EDGES; i++) {
+        unsigned int from = (unsigned int) (rand() % NODES);
+        unsigned int to = i % 3 == 0 ? (unsigned int) (60 + rand() % 10) : (unsigned int) (rand() % NODES);
+        if (i % 7 == 0 && i > 0) {
+            from = edges[i - 1].from;
+            to = edges[i - 1].to;
+        }
+        edges[i] = (struct cds_edge) {.from = from, .to = to};
+        reference[from][to] = true;
+    }
+
+    cds_graph* g = cds_create_csr_graph(NODES, edges, EDGES);
+    assert(g != NULL && cds_graph_kind(g) == CDS_GRAPH_CSR);
+    check(g, reference);
+
+    // single edges keep rows sorted
+    for (int i = 0; i < 500; i++) {
+        unsigned int from = (unsigned int) (rand() % NODES);
+        unsigned int to = (unsigned int) (rand() % NODES);
+        assert(cds_add_edge(g, from, to) == !reference[from][to]);
+        reference[from][to] = true;
+    }
+    check(g, reference);
+    cds_destroy_graph(g);
+
+    // edge list is left untouched, out of range edges are refused
+    assert(edges[7].from == edges[6].from && edges[7].to == edges[6].to);
+    edges[EDGES / 2].to = NODES;
+    assert(cds_create_csr_graph(NODES, edges, EDGES) == NULL);
+    assert(cds_create_csr_graph(-1, edges, 0) == NULL);
+    assert(cds_create_csr_graph(NODES, NULL, 1) == NULL);
+
+    // graphs without edges, or without nodes
+    g = cds_create_csr_graph(NODES, NULL, 0);
+    assert(g != NULL);
+    for (unsigned int node = 0; node < NODES; node++) {
+        size_t count = 1;
+        cds_graph_csr_row(g, node, &count);
+        assert(count == 0 && cds_graph_out_degree(g, node) == 0);
+    }
+    assert(cds_add_edge(g, NODES - 1, 0) && cds_has_edge(g, NODES - 1, 0));
+    cds_destroy_graph(g);
+
+    g = cds_create_csr_graph(0, NULL, 0);
+    assert(g != NULL);
+    cds_destroy_graph(g);
+
+    // rows are only given by CSR graphs
+    cds_graph* matrix = cds_create_graph(4);
+    size_t count = 1;
+    assert(cds_graph_csr_row(matrix, 0, &count) == NULL && count == 0);
+    cds_destroy_graph(matrix);
+
+    free(edges);
+
+    printf("csr_graph: ok\n");
+    return 0;
+}
@@ -0,0 +1,43 @@
+#ifndef CDS_GRAPH_FIXTURE_GUARD_HEADER
+#define CDS_GRAPH_FIXTURE_GUARD_HEADER
+
+#include <stdlib.h>
+
+#include <cds/graph.h>
+
+// Shared by graph tests: a random edge list and the same edges loaded into
+// every backend, tests only keep their own reference and checks.
+
+#define FIXTURE_BACKENDS 3
+
+// random edges between nodes, repeats and self loops included
+static inline struct cds_edge* fixture_edges(int nodes, size_t count, unsigned int seed) {
+    struct cds_edge* edges = malloc(sizeof(struct cds_edge) * count);
+
+    srand(seed);
+    for (size_t i = 0; i < count; i++) {
+        edges[i] = (struct cds_edge) {rand() % nodes, rand() % nodes};
+    }
+
+    return edges;
+}
+
+// matrix, CSR and list graphs in this order, repeated edges kept once
+static inline void fixture_backends(int nodes, const struct cds_edge* edges, size_t count, cds_graph* graphs[FIXTURE_BACKENDS]) {
+    graphs[0] = cds_create_graph(nodes);
+    graphs[1] = cds_create_csr_graph(nodes, edges, count);
+    graphs[2] = cds_create_list_graph(nodes);
+
+    for (size_t i = 0; i < count; i++) {
+        cds_add_edge(graphs[0], edges[i].from, edges[i].to);
+        cds_add_edge(graphs[2], edges[i].from, edges[i].to);
+    }
+}
+
+static inline void fixture_destroy(cds_graph* graphs[FIXTURE_BACKENDS]) {
+    for (size_t backend = 0; backend < FIXTURE_BACKENDS; backend++) {
+        cds_destroy_graph(graphs[backend]);
+    }
+}
+
+#endif // CDS_GRAPH_FIXTURE_GUARD_HEADER
@@ -0,0 +1,184 @@
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <cds/graph.h>
+
+#include "graph_fixture.h"
+
+#define PATH "/tmp/cds_graph_io_test.txt"
+#define CHUNK ((size_t) 1 << 20)
+
+// same nodes and same edges
+static void check_same(cds_graph* g, cds_graph* other) {
+    assert(g != NULL && other != NULL);
+    assert(cds_graph_nodes(g) == cds_graph_nodes(other));
+    for (unsigned int from = 0; from < (unsigned int) cds_graph_nodes(g); from++) {
+        assert(cds_graph_out_degree(g, from) == cds_graph_out_degree(other, from));
+        for (unsigned int to = 0; to < (unsigned int) cds_graph_nodes(g); to++) {
+            assert(cds_has_edge(g, from, to) == cds_has_edge(other, from, to));
+        }
+    }
+}
+
+// write bytes as the whole file
+static void write_file(const char* bytes, size_t count) {
+    FILE* file = fopen(PATH, "wb");
+    assert(file != NULL && fwrite(bytes, 1, count, file) == count);
+    fclose(file);
+}
+
+static cds_graph* load_text(const char* text) {
+    write_file(text, strlen(text));
+    return cds_graph_load_edgelist(PATH, CDS_GRAPH_FORMAT_TEXT);
+}
+
+// a line placed so chunk boundary falls at given offset inside it
+static void check_boundary(const char* line, size_t split, unsigned int from, unsigned int to) {
+    static const char header[] = "# nodes 1000\n";
+    size_t length = strlen(line);
+    char* text = malloc(CHUNK + 64);
+
+    memcpy(text, header, sizeof(header) - 1);
+    size_t used = sizeof(header) - 1;
+    text[used++] = '%';
+    while (used < CHUNK - split - 1) {
+        text[used++] = 'x';
+    }
+    text[used++] = '\n';
+    memcpy(&text[used], line, length);
+    used += length;
+    memcpy(&text[used], "7 8\n", 4);
+    used += 4;
+
+    write_file(text, used);
+    cds_graph* g = cds_graph_load_edgelist(PATH, CDS_GRAPH_FORMAT_TEXT);
+    assert(g != NULL && cds_graph_nodes(g) == 1000);
+    assert(cds_has_edge(g, from, to) && cds_has_edge(g, 7, 8));
+    assert(cds_graph_out_degree(g, from) == (from == 7 ? 2 : 1));
+    cds_destroy_graph(g);
+    free(text);
+}
+
+int main() {
+    // every backend round trips through both formats, files bigger than a chunk
+    int nodes = 60000;
+    size_t count = 300000;
+    struct cds_edge* edges = fixture_edges(nodes, count, 17);
+    cds_graph* graphs[FIXTURE_BACKENDS];
+    fixture_backends(nodes, edges, count, graphs);
+
+    for (size_t backend = 0; backend < FIXTURE_BACKENDS; backend++) {
+        assert(cds_graph_save_edgelist(graphs[backend], PATH, CDS_GRAPH_FORMAT_TEXT) == CDS_OK);
+        cds_graph* loaded = cds_graph_load_edgelist(PATH, CDS_GRAPH_FORMAT_TEXT);
+        assert(loaded != NULL && cds_graph_kind(loaded) == CDS_GRAPH_CSR);
+        for (unsigned int node = 0; node < (unsigned int) nodes; node++) {
+            assert(cds_graph_out_degree(loaded, node) == cds_graph_out_degree(graphs[1], node));
+        }
+        for (size_t i = 0; i < count; i++) {
+            assert(cds_has_edge(loaded, edges[i].from, edges[i].to));
+        }
+        cds_destroy_graph(loaded);
+
+        int fd = open(PATH, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        assert(fd >= 0 && cds_graph_write_fd(graphs[backend], fd, CDS_GRAPH_FORMAT_BINARY) == CDS_OK);
+        close(fd);
+        fd = open(PATH, O_RDONLY);
+        loaded = cds_graph_read_fd(fd, CDS_GRAPH_FORMAT_BINARY);
+        close(fd);
+        assert(loaded != NULL);
+        for (size_t i = 0; i < count; i++) {
+            assert(cds_has_edge(loaded, edges[i].from, edges[i].to));
+        }
+        for (unsigned int node = 0; node < (unsigned int) nodes; node++) {
+            assert(cds_graph_out_degree(loaded, node) == cds_graph_out_degree(graphs[1], node));
+        }
+        cds_destroy_graph(loaded);
+    }
+
+    // binary input cut anywhere is refused
+    assert(cds_graph_save_edgelist(graphs[1], PATH, CDS_GRAPH_FORMAT_BINARY) == CDS_OK);
+    FILE* file = fopen(PATH, "rb");
+    size_t size = 32 + count * 8;
+    char* bytes = malloc(size + 1);
+    size = fread(bytes, 1, size + 1, file);
+    fclose(file);
+    size_t cuts[] = {size - 4, size - 8, CHUNK + 3, 40, 32, 31, 0};
+    for (size_t i = 0; i < sizeof(cuts) / sizeof(cuts[0]); i++) {
+        write_file(bytes, cuts[i]);
+        assert(cds_graph_load_edgelist(PATH, CDS_GRAPH_FORMAT_BINARY) == NULL);
+    }
+    bytes[0] = 'X';
+    write_file(bytes, size);
+    assert(cds_graph_load_edgelist(PATH, CDS_GRAPH_FORMAT_BINARY) == NULL);
+    free(bytes);
+
+    fixture_destroy(graphs);
+    free(edges);
+
+    // small graphs, nodes without edges are kept
+    cds_graph* g = cds_create_list_graph(10);
+    cds_add_edge(g, 0, 9);
+    cds_add_edge(g, 3, 3);
+    for (int format = CDS_GRAPH_FORMAT_TEXT; format <= CDS_GRAPH_FORMAT_BINARY; format++) {
+        assert(cds_graph_save_edgelist(g, PATH, format) == CDS_OK);
+        cds_graph* loaded = cds_graph_load_edgelist(PATH, format);
+        check_same(g, loaded);
+        cds_destroy_graph(loaded);
+    }
+
+    // stdio streams and dot output
+    file = fopen(PATH, "w+");
+    assert(cds_graph_write_file(g, file, CDS_GRAPH_FORMAT_DOT) == CDS_OK);
+    char dot[128] = {0};
+    rewind(file);
+    assert(fread(dot, 1, sizeof(dot) - 1, file) > 0);
+    fclose(file);
+    assert(strcmp(dot, "digraph {\n0 -> 9;\n3 -> 3;\n}\n") == 0);
+    assert(cds_graph_load_edgelist(PATH, CDS_GRAPH_FORMAT_DOT) == NULL);
+    cds_destroy_graph(g);
+
+    // comments, separators and CRLF line endings
+    g = load_text("% comment\r\n# another one\r\n0 1\r\n1,2\r\n2\t3\r\n\r\n  3 , 0 \r\n4 4");
+    assert(g != NULL && cds_graph_nodes(g) == 5);
+    assert(cds_has_edge(g, 0, 1) && cds_has_edge(g, 1, 2) && cds_has_edge(g, 2, 3));
+    assert(cds_has_edge(g, 3, 0) && cds_has_edge(g, 4, 4) && cds_graph_out_degree(g, 4) == 1);
+    cds_destroy_graph(g);
+
+    g = load_text("# nodes 100 edges 1\n5 6\n");
+    assert(g != NULL && cds_graph_nodes(g) == 100 && cds_has_edge(g, 5, 6));
+    cds_destroy_graph(g);
+
+    g = load_text("");
+    assert(g != NULL && cds_graph_nodes(g) == 0);
+    cds_destroy_graph(g);
+
+    // bad lines
+    assert(load_text("0 1\n2\n") == NULL);
+    assert(load_text("0 4294967296\n") == NULL);
+    assert(load_text("# nodes 3\n5 1\n") == NULL);
+
+    // lines split by chunk boundary, even between CR and LF
+    check_boundary("123 456\r\n", 4, 123, 456);
+    check_boundary("123 456\r\n", 7, 123, 456);
+    check_boundary("123 456\r\n", 8, 123, 456);
+    check_boundary("7 999\n", 1, 7, 999);
+    check_boundary("7 999\n", 6, 7, 999);
+
+    // a line longer than a chunk
+    char* text = malloc(CHUNK + 16);
+    memset(text, '1', CHUNK + 8);
+    memcpy(&text[CHUNK + 8], " 1\n", 4);
+    assert(load_text(text) == NULL);
+    free(text);
+
+    assert(cds_graph_load_edgelist("/tmp/cds_missing_directory/graph.txt", CDS_GRAPH_FORMAT_TEXT) == NULL);
+    assert(cds_graph_read_fd(-1, CDS_GRAPH_FORMAT_TEXT) == NULL);
+    remove(PATH);
+
+    printf("graph_io: ok\n");
+    return 0;
+}
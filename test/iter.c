@@ -0,0 +1,266 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/vector.h>
+
+#include "graph_fixture.h"
+
+// iterator over [0, 5) without a container, state kept inside iterator
+static bool count_hasnext(void* structure, void** data) {
+    (void) structure;
+    return *(int*) *data < 5;
+}
+
+static void* count_next(void* structure, void** data) {
+    if (!count_hasnext(structure, data)) {
+        return NULL;
+    }
+    int* current = *data;
+    (*current)++;
+    return current;
+}
+
+static const struct cds_iter_vtable count_vtable = {
+    .has_next = count_hasnext,
+    .next = count_next
+};
+
+// neighbors of every node in every backend, matrix rows span several words
+static void check_neighbors(void) {
+    int nodes = 200;
+    struct cds_edge* edges = fixture_edges(nodes, 2000, 16);
+    cds_graph* graphs[FIXTURE_BACKENDS];
+    fixture_backends(nodes, edges, 2000, graphs);
+
+    for (size_t backend = 0; backend < FIXTURE_BACKENDS; backend++) {
+        cds_graph* g = graphs[backend];
+        for (unsigned int node = 0; node < (unsigned int) nodes; node++) {
+            bool seen[200] = {false};
+            size_t count = 0;
+            unsigned int last = 0;
+
+            CDS_ITER(unsigned int) iter = cds_graph_neighbors(g, node);
+            assert(iter != NULL && cds_iter_valid(iter));
+            CDS_ITER_LOOP(iter, unsigned int*, neighbor, {
+                assert(*neighbor < (unsigned int) nodes && !seen[*neighbor]);
+                assert(cds_has_edge(g, node, *neighbor));
+                // list rows keep insertion order, others are sorted
+                assert(backend == 2 || count == 0 || last < *neighbor);
+                seen[*neighbor] = true;
+                last = *neighbor;
+                count++;
+            });
+            assert(count == cds_graph_out_degree(g, node) && cds_iter_next(iter) == NULL);
+            cds_iter_destroy(iter);
+
+            // stack iterator visits the same ones
+            struct cds_iter_i stack;
+            cds_graph_neighbors_init(&stack, g, node);
+            CDS_ITER_EACH(&stack, unsigned int*, neighbor, {
+                assert(seen[*neighbor]);
+                count--;
+            });
+            assert(count == 0);
+        }
+    }
+
+    assert(cds_graph_neighbors(graphs[0], (unsigned int) nodes) == NULL);
+    assert(cds_graph_neighbors(NULL, 0) == NULL);
+    fixture_destroy(graphs);
+    free(edges);
+
+    // empty words are skipped, bits on word edges are found
+    cds_graph* g = cds_create_graph(nodes);
+    unsigned int targets[] = {0, 63, 64, 127, 128, 191, 199};
+    for (size_t i = 0; i < sizeof(targets) / sizeof(targets[0]); i++) {
+        cds_add_edge(g, 5, targets[i]);
+    }
+    struct cds_iter_i iter;
+    size_t visited = 0;
+    cds_graph_neighbors_init(&iter, g, 5);
+    CDS_ITER_EACH(&iter, unsigned int*, neighbor, {
+        assert(*neighbor == targets[visited++]);
+    });
+    assert(visited == sizeof(targets) / sizeof(targets[0]));
+
+    cds_graph_neighbors_init(&iter, g, 6);
+    assert(!cds_iter_hasnext(&iter) && cds_iter_next(&iter) == NULL);
+    cds_destroy_graph(g);
+}
+
+// contiguous runs from vectors and CSR rows, single elements otherwise
+static void check_batches(void) {
+    CDS_VECTOR(int) vector = CDS_VECTOR_NEW(int);
+    for (int i = 0; i < 100; i++) {
+        cds_vector_pushback(vector, &i);
+    }
+
+    struct cds_iter_i iter;
+    void* run;
+    cds_vector_iter_init(&iter, vector);
+    assert(cds_iter_next_batch(&iter, &run, 0) == 0);
+    assert(*(int*) cds_iter_next(&iter) == 0);
+    assert(cds_iter_next_batch(&iter, &run, 30) == 30 && run == cds_vector_ptr_at(vector, 1));
+    assert(cds_iter_next_batch(&iter, &run, SIZE_MAX) == 69 && *(int*) run == 31);
+    assert(cds_iter_next_batch(&iter, &run, SIZE_MAX) == 0 && !cds_iter_hasnext(&iter));
+
+    // runs of any size cover every element once
+    int expected = 0;
+    cds_vector_iter_init(&iter, vector);
+    for (size_t max = 1; cds_iter_hasnext(&iter); max++) {
+        size_t count = cds_iter_next_batch(&iter, &run, max);
+        assert(count == max || expected + (int) count == 100);
+        for (size_t i = 0; i < count; i++) {
+            assert(((int*) run)[i] == expected++);
+        }
+    }
+    assert(expected == 100);
+
+    // reverse iterators give an element at a time
+    cds_vector_riter_init(&iter, vector);
+    assert(cds_iter_next_batch(&iter, &run, SIZE_MAX) == 1 && *(int*) run == 99);
+
+    // stale iterators give nothing
+    cds_vector_iter_init(&iter, vector);
+    cds_vector_popback(vector, NULL);
+    assert(cds_iter_next_batch(&iter, &run, SIZE_MAX) == 0);
+    cds_vector_destroy(vector);
+
+    int nodes = 150;
+    struct cds_edge* edges = fixture_edges(nodes, 3000, 25);
+    cds_graph* graphs[FIXTURE_BACKENDS];
+    fixture_backends(nodes, edges, 3000, graphs);
+
+    for (size_t backend = 0; backend < FIXTURE_BACKENDS; backend++) {
+        for (unsigned int node = 0; node < (unsigned int) nodes; node++) {
+            size_t degree = cds_graph_out_degree(graphs[backend], node);
+            size_t total = 0;
+            size_t count;
+
+            cds_graph_neighbors_init(&iter, graphs[backend], node);
+            while ((count = cds_iter_next_batch(&iter, &run, 4)) != 0) {
+                // matrix rows are bits, their neighbors come one by one
+                assert(backend == 0 ? count == 1 : count == (degree - total < 4 ? degree - total : 4));
+                for (size_t i = 0; i < count; i++) {
+                    assert(cds_has_edge(graphs[backend], node, ((unsigned int*) run)[i]));
+                }
+                total += count;
+            }
+            assert(total == degree);
+
+            // CSR runs point into the row itself
+            if (backend == 1 && degree != 0) {
+                size_t row_count;
+                const unsigned int* row = cds_graph_csr_row(graphs[backend], node, &row_count);
+                cds_graph_neighbors_init(&iter, graphs[backend], node);
+                assert(cds_iter_next_batch(&iter, &run, SIZE_MAX) == row_count && run == row);
+            }
+        }
+    }
+
+    fixture_destroy(graphs);
+    free(edges);
+}
+
+int main() {
+    CDS_VECTOR(int) vector = CDS_VECTOR_NEW(int);
+    for (int i = 0; i < 20; i++) {
+        assert(cds_vector_pushback(vector, &i) == CDS_OK);
+    }
+
+    // stack iterators walk every element in both directions
+    struct cds_iter_i iter;
+    cds_vector_iter_init(&iter, vector);
+    assert(!iter.owned && cds_iter_valid(&iter));
+    int expected = 0;
+    CDS_ITER_EACH(&iter, int*, value, {
+        assert(*value == expected++);
+    });
+    assert(expected == 20 && !cds_iter_hasnext(&iter));
+    assert(cds_iter_hasback(&iter) && *(int*) cds_iter_back(&iter) == 19);
+
+    struct cds_iter_i reverse;
+    cds_vector_riter_init(&reverse, vector);
+    CDS_ITER_LOOP(&reverse, int*, value, {
+        assert(*value == --expected);
+    });
+    assert(expected == 0 && cds_iter_next(&reverse) == NULL);
+
+    int sum = 0;
+    CDS_VECTOR_LOOP(vector, int*, value, {
+        sum += *value;
+    });
+    assert(sum == 190);
+
+    // every iterator of a kind shares one vtable, stack or heap
+    CDS_ITER(int) begin = cds_vector_begin(vector);
+    CDS_ITER(int) end = cds_vector_end(vector);
+    CDS_ITER(int) rbegin = cds_vector_rbegin(vector);
+    assert(begin != NULL && end != NULL && rbegin != NULL);
+    assert(begin->owned && begin->vtable == end->vtable && begin->vtable == iter.vtable);
+    assert(rbegin->vtable == reverse.vtable && rbegin->vtable != begin->vtable);
+    assert(begin->data == begin->state);
+
+    assert(cds_iter_distance(begin, end) == 20 && !cds_iter_similar(begin, end));
+    for (int i = 0; i < 20; i++) {
+        assert(*(int*) cds_iter_next(begin) == i);
+    }
+    assert(cds_iter_similar(begin, end) && cds_iter_distance(end, begin) == 0);
+    assert(*(int*) cds_iter_next(rbegin) == 19);
+
+    // copy between iterators, both live in the stack
+    struct cds_iter_i first;
+    struct cds_iter_i last;
+    cds_vector_iter_init(&first, vector);
+    cds_vector_iter_init(&last, vector);
+    for (int i = 0; i < 15; i++) {
+        cds_iter_next(&last);
+    }
+    cds_iter_next(&first);
+    CDS_VECTOR(int) part = cds_vector_from(vector, &first, &last);
+    int value;
+    assert(cds_vector_size(part) == 14 && cds_vector_front(part, &value) == CDS_OK && value == 1);
+    cds_vector_destroy(part);
+
+    // invalid iterators fall back to whole vector
+    CDS_VECTOR(int) whole = cds_vector_from(vector, NULL, NULL);
+    assert(cds_vector_size(whole) == 20 && cds_vector_back(whole, &value) == CDS_OK && value == 19);
+    cds_vector_destroy(whole);
+
+    // any change invalidates every iterator
+    cds_vector_iter_init(&iter, vector);
+    value = 20;
+    cds_vector_pushback(vector, &value);
+    assert(!cds_iter_valid(&iter) && !cds_iter_valid(begin) && !cds_iter_hasnext(&iter));
+    assert(cds_iter_next(&iter) == NULL && cds_iter_back(rbegin) == NULL);
+
+    // stack iterators are only released, heap ones freed
+    cds_iter_destroy(&iter);
+    cds_iter_destroy(begin);
+    cds_iter_destroy(end);
+    cds_iter_destroy(rbegin);
+
+    // iterators over anything, with a custom vtable
+    struct cds_iter_i counter;
+    cds_iter_init(&counter, &counter, &count_vtable, counter.state);
+    *(int*) counter.state = 0;
+    int visited = 0;
+    CDS_ITER_EACH(&counter, int*, current, {
+        assert(*current == ++visited);
+    });
+    assert(visited == 5 && !cds_iter_valid(&counter) && !cds_iter_hasback(&counter));
+    assert(cds_iter_distance(&counter, &counter) == 0 && !cds_iter_similar(&counter, &counter));
+    cds_iter_destroy(&counter);
+
+    CDS_ITER(int) created = cds_iter_create(vector, (struct cds_iter_config) {.memory = cds_memory_system()});
+    assert(created == NULL);
+
+    cds_vector_destroy(vector);
+
+    check_neighbors();
+    check_batches();
+
+    printf("iter: ok\n");
+    return 0;
+}
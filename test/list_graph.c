@@ -0,0 +1,39 @@
+#include <assert.h>
+#include <stdio.h>
+
+#include <cds/graph.h>
+
+int main() {
+    cds_graph* g = cds_create_list_graph(3);
+    double weight;
+
+    assert(cds_add_weighted_edge(g, 0, 1, 2.5));
+    assert(!cds_add_weighted_edge(g, 0, 1, 3));
+    assert(cds_add_edge(g, 0, 2) && cds_add_edge(g, 2, 0));
+    assert(cds_edge_weight(g, 0, 1, &weight) && weight == 2.5);
+    assert(cds_edge_weight(g, 0, 2, &weight) && weight == 1);
+
+    // new nodes get empty rows, unchecked edges skip the repeat scan
+    assert(cds_add_node(g) == 3 && cds_graph_nodes(g) == 4);
+    for (unsigned int node = 0; node < 3; node++) {
+        assert(cds_add_edge_unchecked(g, 3, node, node + 1));
+    }
+    assert(cds_graph_out_degree(g, 3) == 3);
+    assert(cds_edge_weight(g, 3, 2, &weight) && weight == 3);
+
+    assert(cds_remove_edge(g, 0, 1) && !cds_has_edge(g, 0, 1) && cds_has_edge(g, 0, 2));
+    assert(!cds_remove_edge(g, 0, 1));
+    assert(cds_remove_edge(g, 3, 0) && cds_graph_out_degree(g, 3) == 2);
+    assert(cds_edge_weight(g, 3, 2, &weight) && weight == 3);
+
+    cds_destroy_graph(g);
+
+    // matrix graphs only take unweighted edges, checked as usual
+    g = cds_create_graph(2);
+    assert(cds_add_edge_unchecked(g, 0, 1, 1) && !cds_add_edge_unchecked(g, 0, 1, 1));
+    assert(!cds_add_edge_unchecked(g, 1, 0, 2));
+    cds_destroy_graph(g);
+
+    printf("list_graph: ok\n");
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/graph.h>
+
+#define MAX_NODES 200
+
+// row bits match reference, nothing set past last node
+static void check_row(cds_graph* g, unsigned int nodes, unsigned int node, const bool* reference) {
+    size_t words;
+    const uint64_t* row = cds_graph_matrix_row(g, node, &words);
+    assert(row != NULL && words * 64 >= nodes && (uintptr_t) row % 64 == 0);
+
+    size_t degree = 0;
+    for (size_t bit = 0; bit < words * 64; bit++) {
+        bool set = (row[bit / 64] >> (bit % 64)) & 1;
+        assert(set == (bit < nodes && reference[bit]));
+        degree += set;
+    }
+    assert(cds_graph_out_degree(g, node) == degree);
+}
+
+// common neighbors counted by merging sorted CSR rows
+static size_t merge_common(cds_graph* csr, unsigned int a, unsigned int b) {
+    size_t a_count, b_count;
+    const unsigned int* a_row = cds_graph_csr_row(csr, a, &a_count);
+    const unsigned int* b_row = cds_graph_csr_row(csr, b, &b_count);
+
+    size_t common = 0;
+    for (size_t i = 0, j = 0; i < a_count && j < b_count;) {
+        if (a_row[i] == b_row[j]) {
+            common++;
+            i++;
+            j++;
+        } else if (a_row[i] < b_row[j]) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+    return common;
+}
+
+// row operations on every pair of rows around word boundaries
+static void check_nodes(int nodes) {
+    static bool reference[MAX_NODES][MAX_NODES];
+    static struct cds_edge edges[MAX_NODES * 8];
+    size_t count = 0;
+
+    cds_graph* g = cds_create_graph(nodes);
+    assert(g != NULL && cds_graph_kind(g) == CDS_GRAPH_MATRIX);
+
+    // targets cluster on both sides of each word boundary
+    for (int from = 0; from < nodes; from++) {
+        for (int to = 0; to < nodes; to++) {
+            reference[from][to] = false;
+        }
+        for (int k = 0; k < 8; k++) {
+            int to = k % 2 == 0 ? rand() % nodes : (64 * (rand() % 4) + rand() % 6 - 3 + nodes) % nodes;
+            bool added = cds_add_edge(g, (unsigned int) from, (unsigned int) to);
+            assert(added == !reference[from][to]);
+            reference[from][to] = true;
+            edges[count++] = (struct cds_edge) {.from = (unsigned int) from, .to = (unsigned int) to};
+        }
+    }
+
+    cds_graph* csr = cds_create_csr_graph(nodes, edges, count);
+    assert(csr != NULL);
+
+    for (int node = 0; node < nodes; node++) {
+        check_row(g, (unsigned int) nodes, (unsigned int) node, reference[node]);
+        for (int to = 0; to < nodes; to++) {
+            assert(cds_has_edge(g, (unsigned int) node, (unsigned int) to) == reference[node][to]);
+        }
+    }
+
+    for (int a = 0; a < nodes; a++) {
+        for (int b = 0; b < nodes; b++) {
+            size_t common = 0;
+            for (int to = 0; to < nodes; to++) {
+                common += reference[a][to] && reference[b][to];
+            }
+            assert(cds_graph_common_neighbors(g, (unsigned int) a, (unsigned int) b) == common);
+            assert(merge_common(csr, (unsigned int) a, (unsigned int) b) == common);
+        }
+    }
+
+    // and, then or, each between two rows, degrees come back
+    for (int i = 0; i < nodes; i++) {
+        unsigned int dst = (unsigned int) (rand() % nodes);
+        unsigned int src = (unsigned int) (rand() % nodes);
+        bool combine_and = i % 2 == 0;
+
+        size_t degree = 0;
+        for (unsigned int to = 0; to < (unsigned int) nodes; to++) {
+            reference[dst][to] = combine_and ? reference[dst][to] && reference[src][to] : reference[dst][to] || reference[src][to];
+            degree += reference[dst][to];
+        }
+
+        size_t result = combine_and ? cds_graph_row_and(g, dst, src) : cds_graph_row_or(g, dst, src);
+        assert(result == degree);
+        check_row(g, (unsigned int) nodes, dst, reference[dst]);
+        check_row(g, (unsigned int) nodes, src, reference[src]);
+    }
+
+    // a row combined with itself stays the same
+    size_t degree = cds_graph_out_degree(g, 0);
+    assert(cds_graph_row_and(g, 0, 0) == degree && cds_graph_row_or(g, 0, 0) == degree);
+
+    size_t words = 1;
+    assert(cds_graph_matrix_row(csr, 0, &words) == NULL && words == 0);
+
+    cds_destroy_graph(csr);
+    cds_destroy_graph(g);
+}
+
+int main() {
+    srand(12);
+
+    // row lengths on both sides of word and cache line boundaries
+    int sizes[] = {1, 63, 64, 65, 127, 128, 129, 200};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        check_nodes(sizes[i]);
+    }
+
+    // last node sits in the last bit of a word
+    cds_graph* g = cds_create_graph(128);
+    assert(cds_add_edge(g, 127, 127) && cds_add_edge(g, 0, 63) && cds_add_edge(g, 0, 64));
+    assert(cds_graph_common_neighbors(g, 0, 127) == 0);
+    assert(cds_graph_row_or(g, 127, 0) == 3);
+    assert(cds_graph_common_neighbors(g, 0, 127) == 2);
+    assert(cds_graph_row_and(g, 0, 127) == 2);
+    assert(cds_has_edge(g, 0, 63) && cds_has_edge(g, 0, 64) && !cds_has_edge(g, 0, 127));
+    cds_destroy_graph(g);
+
+    g = cds_create_graph(0);
+    assert(g != NULL);
+    cds_destroy_graph(g);
+
+    printf("matrix_graph: ok\n");
+    return 0;
+}
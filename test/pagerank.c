@@ -0,0 +1,122 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/graph.h>
+
+#define DAMPING 0.85
+#define TOLERANCE 1e-12
+
+// plain power iteration over the edge list, dangling rank spread to everyone
+static void reference(int nodes, const struct cds_edge* edges, size_t count, double* rank) {
+    size_t* degree = calloc(nodes, sizeof(size_t));
+    double* next = malloc(sizeof(double) * nodes);
+
+    for (size_t i = 0; i < count; i++) {
+        degree[edges[i].from]++;
+    }
+    for (int node = 0; node < nodes; node++) {
+        rank[node] = 1.0 / nodes;
+    }
+
+    for (int iteration = 0; iteration < 1000; iteration++) {
+        double dangling = 0, delta = 0;
+        for (int node = 0; node < nodes; node++) {
+            dangling += degree[node] == 0 ? rank[node] : 0;
+        }
+        for (int node = 0; node < nodes; node++) {
+            next[node] = (1 - DAMPING) / nodes + DAMPING * dangling / nodes;
+        }
+        for (size_t i = 0; i < count; i++) {
+            next[edges[i].to] += DAMPING * rank[edges[i].from] / degree[edges[i].from];
+        }
+        for (int node = 0; node < nodes; node++) {
+            delta += fabs(next[node] - rank[node]);
+            rank[node] = next[node];
+        }
+        if (delta < TOLERANCE) {
+            break;
+        }
+    }
+
+    free(degree);
+    free(next);
+}
+
+static void check(cds_graph* g, const double* expected, size_t nthreads) {
+    int nodes = cds_graph_nodes(g);
+    double* scores = malloc(sizeof(double) * nodes);
+    double sum = 0;
+
+    assert(cds_graph_pagerank(g, DAMPING, TOLERANCE, nthreads, scores) == CDS_OK);
+    for (int node = 0; node < nodes; node++) {
+        assert(fabs(scores[node] - expected[node]) < 1e-9);
+        sum += scores[node];
+    }
+    assert(fabs(sum - 1) < 1e-9);
+
+    free(scores);
+}
+
+int main() {
+    // node 0 has no in-edges, r1 = 0.9 / 1.85, r1 + r2 = 0.95
+    struct cds_edge cycle[] = {{0, 1}, {1, 2}, {2, 1}};
+    cds_graph* g = cds_create_csr_graph(3, cycle, 3);
+    check(g, (double[]) {0.05, 0.9 / 1.85, 0.95 - 0.9 / 1.85}, 1);
+    cds_destroy_graph(g);
+
+    // 1 and 2 are dangling, r0 = 1 / 3.85 and r1 = r2 = 1.425 r0
+    struct cds_edge fork[] = {{0, 1}, {0, 2}};
+    g = cds_create_list_graph(3);
+    cds_add_edge(g, fork[0].from, fork[0].to);
+    cds_add_edge(g, fork[1].from, fork[1].to);
+    check(g, (double[]) {1 / 3.85, 1.425 / 3.85, 1.425 / 3.85}, 1);
+    cds_destroy_graph(g);
+
+    // no edges at all, every node keeps 1 / N
+    g = cds_create_graph(5);
+    check(g, (double[]) {0.2, 0.2, 0.2, 0.2, 0.2}, 1);
+    cds_destroy_graph(g);
+
+    double* scores = malloc(sizeof(double) * 5);
+    g = cds_create_csr_graph(5, cycle, 3);
+    assert(cds_graph_pagerank(g, 1, TOLERANCE, 1, scores) == CDS_ERR);
+    assert(cds_graph_pagerank(g, DAMPING, 0, 1, scores) == CDS_ERR);
+    cds_destroy_graph(g);
+    free(scores);
+
+    // large enough for workers, first and last nodes have no in-edges and
+    // some nodes are dangling
+    srand(21);
+    int nodes = 20000;
+    size_t count = 60000;
+    struct cds_edge* edges = malloc(sizeof(struct cds_edge) * count);
+    // each source gets distinct targets, repeated edges would be dropped
+    for (size_t i = 0; i < count; i++) {
+        unsigned int from = i % (nodes - 500);
+        edges[i] = (struct cds_edge) {from, 100 + (from * 7919 + (i / (nodes - 500)) * 4099 + rand() % 4000) % (nodes - 200)};
+    }
+
+    double* expected = malloc(sizeof(double) * nodes);
+    reference(nodes, edges, count, expected);
+
+    g = cds_create_csr_graph(nodes, edges, count);
+    check(g, expected, 1);
+    check(g, expected, 4);
+    cds_destroy_graph(g);
+
+    // edgeless graph split between workers
+    g = cds_create_csr_graph(nodes, NULL, 0);
+    for (int node = 0; node < nodes; node++) {
+        expected[node] = 1.0 / nodes;
+    }
+    check(g, expected, 4);
+    cds_destroy_graph(g);
+
+    free(edges);
+    free(expected);
+
+    printf("pagerank: ok\n");
+    return 0;
+}
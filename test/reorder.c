@@ -0,0 +1,97 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/graph.h>
+
+#include "graph_fixture.h"
+
+static void check(cds_graph* g, enum cds_graph_order strategy) {
+    int nodes = cds_graph_nodes(g);
+    unsigned int* perm = malloc(sizeof(unsigned int) * nodes);
+    unsigned int* inverse = malloc(sizeof(unsigned int) * nodes);
+    size_t* degree = calloc(nodes, sizeof(size_t));
+
+    cds_graph* reordered = cds_graph_reorder(g, strategy, perm);
+    assert(reordered != NULL);
+    assert(cds_graph_kind(reordered) == cds_graph_kind(g) && cds_graph_nodes(reordered) == nodes);
+
+    // a permutation
+    for (int node = 0; node < nodes; node++) {
+        inverse[node] = CDS_GRAPH_UNREACHED;
+    }
+    for (int node = 0; node < nodes; node++) {
+        assert(perm[node] < (unsigned int) nodes && inverse[perm[node]] == CDS_GRAPH_UNREACHED);
+        inverse[perm[node]] = node;
+    }
+
+    // same edges and weights under new ids, nothing else
+    for (int from = 0; from < nodes; from++) {
+        for (int to = 0; to < nodes; to++) {
+            double weight, moved;
+            bool edge = cds_edge_weight(g, from, to, &weight);
+
+            assert(cds_has_edge(reordered, perm[from], perm[to]) == edge);
+            if (edge) {
+                assert(cds_edge_weight(reordered, perm[from], perm[to], &moved) && moved == weight);
+                degree[from]++;
+                degree[to]++;
+            }
+        }
+    }
+
+    if (strategy == CDS_GRAPH_ORDER_DEGREE) {
+        for (int id = 1; id < nodes; id++) {
+            assert(degree[inverse[id - 1]] >= degree[inverse[id]]);
+        }
+    }
+    if (strategy == CDS_GRAPH_ORDER_BFS) {
+        assert(perm[0] == 0);
+    }
+
+    cds_destroy_graph(reordered);
+    free(perm);
+    free(inverse);
+    free(degree);
+}
+
+int main() {
+    enum cds_graph_order strategies[] = {CDS_GRAPH_ORDER_RCM, CDS_GRAPH_ORDER_DEGREE, CDS_GRAPH_ORDER_BFS};
+
+    // a few components and isolated nodes, list edges are weighted
+    int nodes = 200;
+    size_t count = 300;
+    struct cds_edge* edges = fixture_edges(nodes - 20, count, 22);
+    cds_graph* graphs[FIXTURE_BACKENDS];
+    fixture_backends(nodes, edges, count, graphs);
+
+    cds_destroy_graph(graphs[2]);
+    graphs[2] = cds_create_list_graph(nodes);
+    for (size_t i = 0; i < count; i++) {
+        cds_add_weighted_edge(graphs[2], edges[i].from, edges[i].to, edges[i].from + edges[i].to * 0.5);
+    }
+
+    for (size_t backend = 0; backend < FIXTURE_BACKENDS; backend++) {
+        for (size_t strategy = 0; strategy < 3; strategy++) {
+            check(graphs[backend], strategies[strategy]);
+        }
+    }
+    fixture_destroy(graphs);
+
+    // single path reversed keeps neighbors next to each other
+    struct cds_edge path[] = {{4, 2}, {2, 0}, {0, 3}, {3, 1}};
+    cds_graph* g = cds_create_csr_graph(5, path, 4);
+    unsigned int perm[5];
+    cds_graph* reordered = cds_graph_reorder(g, CDS_GRAPH_ORDER_RCM, perm);
+    for (size_t i = 0; i < 4; i++) {
+        int gap = (int) perm[path[i].from] - (int) perm[path[i].to];
+        assert(gap == 1 || gap == -1);
+    }
+    cds_destroy_graph(reordered);
+    cds_destroy_graph(g);
+
+    free(edges);
+
+    printf("reorder: ok\n");
+    return 0;
+}
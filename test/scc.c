@@ -0,0 +1,151 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/graph.h>
+
+#include "graph_fixture.h"
+
+// reach[a * nodes + b] when b is reachable from a, by DFS from every node
+static bool* closure(int nodes, const struct cds_edge* edges, size_t count) {
+    bool* reach = calloc((size_t) nodes * nodes, sizeof(bool));
+    unsigned int* stack = malloc(sizeof(unsigned int) * nodes);
+
+    for (int source = 0; source < nodes; source++) {
+        bool* row = reach + (size_t) source * nodes;
+        size_t top = 0;
+        row[source] = true;
+        stack[top++] = source;
+        while (top > 0) {
+            unsigned int node = stack[--top];
+            for (size_t i = 0; i < count; i++) {
+                if (edges[i].from == node && !row[edges[i].to]) {
+                    row[edges[i].to] = true;
+                    stack[top++] = edges[i].to;
+                }
+            }
+        }
+    }
+
+    free(stack);
+    return reach;
+}
+
+static void check_scc(cds_graph* g, int nodes, const struct cds_edge* edges, size_t count) {
+    bool* reach = closure(nodes, edges, count);
+    unsigned int* labels = malloc(sizeof(unsigned int) * nodes);
+    bool* used = calloc(nodes, sizeof(bool));
+    unsigned int largest = 0;
+
+    assert(cds_graph_scc(g, labels) == CDS_OK);
+
+    for (int a = 0; a < nodes; a++) {
+        for (int b = 0; b < nodes; b++) {
+            bool mutual = reach[(size_t) a * nodes + b] && reach[(size_t) b * nodes + a];
+            assert(mutual == (labels[a] == labels[b]));
+        }
+        assert(labels[a] < (unsigned int) nodes);
+        used[labels[a]] = true;
+        largest = labels[a] > largest ? labels[a] : largest;
+    }
+
+    // dense labels in topological order of condensation
+    for (unsigned int label = 0; label <= largest; label++) {
+        assert(used[label]);
+    }
+    for (size_t i = 0; i < count; i++) {
+        assert(labels[edges[i].from] <= labels[edges[i].to]);
+    }
+
+    free(reach);
+    free(labels);
+    free(used);
+}
+
+static void check_order(int nodes, const struct cds_edge* edges, size_t count, const unsigned int* order) {
+    unsigned int* position = malloc(sizeof(unsigned int) * nodes);
+    memset(position, 0xff, sizeof(unsigned int) * nodes);
+
+    for (int i = 0; i < nodes; i++) {
+        assert(order[i] < (unsigned int) nodes && position[order[i]] == CDS_GRAPH_UNREACHED);
+        position[order[i]] = i;
+    }
+    for (size_t i = 0; i < count; i++) {
+        assert(position[edges[i].from] < position[edges[i].to]);
+    }
+
+    free(position);
+}
+
+int main() {
+    // {0, 1, 2} cycle feeding {3, 4} cycle, 5 alone
+    struct cds_edge small[] = {{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}, {4, 3}};
+    cds_graph* g = cds_create_csr_graph(6, small, 6);
+    unsigned int labels[6], order[6];
+    assert(cds_graph_scc(g, labels) == CDS_OK);
+    assert(labels[0] == labels[1] && labels[1] == labels[2]);
+    assert(labels[3] == labels[4] && labels[0] < labels[3]);
+    assert(labels[5] != labels[0] && labels[5] != labels[3]);
+    assert(cds_graph_toposort(g, order) == CDS_ERR);
+    cds_destroy_graph(g);
+
+    // random graphs, sparse enough to have several nontrivial components
+    int nodes = 300;
+    size_t count = 400;
+    struct cds_edge* edges = fixture_edges(nodes, count, 19);
+    cds_graph* graphs[FIXTURE_BACKENDS];
+    fixture_backends(nodes, edges, count, graphs);
+    for (size_t backend = 0; backend < FIXTURE_BACKENDS; backend++) {
+        check_scc(graphs[backend], nodes, edges, count);
+    }
+    fixture_destroy(graphs);
+
+    // same edges turned into a DAG, from lower to higher index
+    for (size_t i = 0; i < count; i++) {
+        unsigned int a = edges[i].from, b = edges[i].to != a ? edges[i].to : (a + 1) % nodes;
+        edges[i] = a < b ? (struct cds_edge) {a, b} : (struct cds_edge) {b, a};
+    }
+
+    unsigned int* dag_order = malloc(sizeof(unsigned int) * nodes);
+    g = cds_create_csr_graph(nodes, edges, count);
+    assert(cds_graph_toposort(g, dag_order) == CDS_OK);
+    check_order(nodes, edges, count, dag_order);
+    check_scc(g, nodes, edges, count);
+    cds_destroy_graph(g);
+    free(dag_order);
+    free(edges);
+
+    // deep chain closed into one cycle, must not overflow stack
+    int deep = 1000000;
+    edges = malloc(sizeof(struct cds_edge) * deep);
+    for (int i = 0; i < deep; i++) {
+        edges[i] = (struct cds_edge) {i, (i + 1) % deep};
+    }
+
+    unsigned int* deep_labels = malloc(sizeof(unsigned int) * deep);
+    g = cds_create_csr_graph(deep, edges, deep);
+    assert(cds_graph_scc(g, deep_labels) == CDS_OK);
+    for (int i = 0; i < deep; i++) {
+        assert(deep_labels[i] == 0);
+    }
+    assert(cds_graph_toposort(g, deep_labels) == CDS_ERR);
+    cds_destroy_graph(g);
+
+    // and opened back into a chain
+    g = cds_create_csr_graph(deep, edges, deep - 1);
+    assert(cds_graph_toposort(g, deep_labels) == CDS_OK);
+    for (int i = 0; i < deep; i++) {
+        assert(deep_labels[i] == (unsigned int) i);
+    }
+    assert(cds_graph_scc(g, deep_labels) == CDS_OK);
+    for (int i = 0; i < deep; i++) {
+        assert(deep_labels[i] == (unsigned int) i);
+    }
+    cds_destroy_graph(g);
+    free(deep_labels);
+    free(edges);
+
+    printf("scc: ok\n");
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/graph.h>
+
+#include "graph_fixture.h"
+
+#define PATH "/tmp/cds_snapshot_test.bin"
+
+// same edges, same successors in ascending order
+static void check_same(cds_graph* expected, cds_graph* mapped) {
+    int nodes = cds_graph_nodes(expected);
+    assert(cds_graph_nodes(mapped) == nodes);
+    assert(cds_graph_kind(mapped) == CDS_GRAPH_CSR);
+
+    for (int from = 0; from < nodes; from++) {
+        unsigned int previous = 0;
+        size_t degree = 0;
+
+        CDS_ITER(unsigned int) iter = cds_graph_neighbors(mapped, from);
+        CDS_ITER_EACH(iter, unsigned int*, to, {
+            assert(*to < (unsigned int) nodes && cds_has_edge(expected, from, *to));
+            assert(degree == 0 || *to > previous);
+            previous = *to;
+            degree++;
+        })
+        cds_iter_destroy(iter);
+
+        assert(degree == cds_graph_out_degree(expected, from));
+        assert(cds_graph_out_degree(mapped, from) == degree);
+        for (int to = 0; to < nodes; to++) {
+            assert(cds_has_edge(mapped, from, to) == cds_has_edge(expected, from, to));
+        }
+    }
+}
+
+// overwrite offset of node in saved snapshot
+static void corrupt(unsigned int node, uint64_t offset) {
+    FILE* file = fopen(PATH, "r+b");
+    assert(file != NULL);
+    assert(fseek(file, 4096 + sizeof(uint64_t) * node, SEEK_SET) == 0);
+    assert(fwrite(&offset, sizeof(offset), 1, file) == 1);
+    assert(fclose(file) == 0);
+}
+
+int main() {
+    int nodes = 500;
+    size_t count = 4000;
+    struct cds_edge* edges = fixture_edges(nodes, count, 20);
+    cds_graph* graphs[FIXTURE_BACKENDS];
+    fixture_backends(nodes, edges, count, graphs);
+
+    // every backend maps back as sorted CSR rows, list rows are unsorted
+    for (size_t backend = 0; backend < FIXTURE_BACKENDS; backend++) {
+        assert(cds_graph_save_snapshot(graphs[backend], PATH) == CDS_OK);
+        cds_graph* mapped = cds_graph_open_mapped(PATH, backend % 2 == 0);
+        assert(mapped != NULL && cds_graph_readonly(mapped) && !cds_graph_readonly(graphs[backend]));
+        check_same(graphs[backend], mapped);
+
+        // changes are refused
+        assert(!cds_add_edge(mapped, 0, 1) && !cds_remove_edge(mapped, edges[0].from, edges[0].to));
+        assert(cds_add_node(mapped) == -1);
+        assert(cds_has_edge(mapped, edges[0].from, edges[0].to));
+        cds_destroy_graph(mapped);
+    }
+
+    // offsets are checked even without verify
+    corrupt(1, count + 1);
+    assert(cds_graph_open_mapped(PATH, false) == NULL);
+    corrupt(1, 0);
+    corrupt(2, 2);
+    corrupt(3, 1);
+    assert(cds_graph_open_mapped(PATH, false) == NULL);
+    assert(cds_graph_open_mapped(PATH, true) == NULL);
+    corrupt(3, 2);
+    cds_graph* mapped = cds_graph_open_mapped(PATH, false);
+    assert(mapped != NULL);
+    cds_destroy_graph(mapped);
+
+    // edgeless graph and missing file
+    cds_graph* empty = cds_create_csr_graph(3, NULL, 0);
+    assert(cds_graph_save_snapshot(empty, PATH) == CDS_OK);
+    mapped = cds_graph_open_mapped(PATH, true);
+    assert(mapped != NULL && cds_graph_nodes(mapped) == 3 && !cds_has_edge(mapped, 0, 0));
+    cds_destroy_graph(mapped);
+    cds_destroy_graph(empty);
+
+    remove(PATH);
+    assert(cds_graph_open_mapped(PATH, false) == NULL);
+
+    fixture_destroy(graphs);
+    free(edges);
+
+    printf("snapshot: ok\n");
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/graph.h>
+
+#include "graph_fixture.h"
+
+struct weighted_edge {
+    unsigned int from;
+    unsigned int to;
+    double weight;
+};
+
+// Bellman-Ford, relaxes every edge until nothing changes
+static void reference(int nodes, const struct weighted_edge* edges, size_t count, unsigned int source, double* dist) {
+    for (int node = 0; node < nodes; node++) {
+        dist[node] = INFINITY;
+    }
+    dist[source] = 0;
+
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t i = 0; i < count; i++) {
+            if (dist[edges[i].from] + edges[i].weight < dist[edges[i].to]) {
+                dist[edges[i].to] = dist[edges[i].from] + edges[i].weight;
+                changed = true;
+            }
+        }
+    }
+}
+
+// distances are sums of small integers, so they compare exactly
+static void check(cds_graph* g, int nodes, const double* expected, const double* dist, const unsigned int* pred, unsigned int source) {
+    for (int node = 0; node < nodes; node++) {
+        assert(dist[node] == expected[node]);
+
+        if (dist[node] == INFINITY) {
+            assert(pred[node] == CDS_GRAPH_UNREACHED);
+        } else if ((unsigned int) node != source) {
+            double weight;
+            assert(cds_edge_weight(g, pred[node], node, &weight));
+            assert(dist[pred[node]] + weight == dist[node]);
+        }
+    }
+}
+
+int main() {
+    // 0 -> 1 (4), 0 -> 2 (1), 2 -> 1 (2), 1 -> 3 (1), 3 unreachable from 4
+    cds_graph* g = cds_create_list_graph(5);
+    cds_add_weighted_edge(g, 0, 1, 4);
+    cds_add_weighted_edge(g, 0, 2, 1);
+    cds_add_weighted_edge(g, 2, 1, 2);
+    cds_add_weighted_edge(g, 1, 3, 1);
+
+    double dist[5];
+    unsigned int pred[5];
+    assert(cds_graph_sssp(g, 0, dist, pred) == CDS_OK);
+    assert(dist[0] == 0 && dist[1] == 3 && dist[2] == 1 && dist[3] == 4 && dist[4] == INFINITY);
+    assert(pred[0] == 0 && pred[1] == 2 && pred[3] == 1 && pred[4] == CDS_GRAPH_UNREACHED);
+
+    // negative weights are refused
+    cds_add_weighted_edge(g, 4, 0, -1);
+    assert(cds_graph_sssp(g, 0, dist, pred) == CDS_ERR);
+    assert(cds_graph_sssp_parallel(g, 0, dist, pred, 0, 2) == CDS_ERR);
+    cds_destroy_graph(g);
+
+    // random graph with zero weights, large enough for delta-stepping
+    int nodes = 5000;
+    size_t count = 25000;
+    struct cds_edge* random = fixture_edges(nodes, count, 15);
+    struct weighted_edge* edges = malloc(sizeof(struct weighted_edge) * count);
+    g = cds_create_list_graph(nodes);
+
+    size_t added = 0;
+    for (size_t i = 0; i < count; i++) {
+        struct weighted_edge edge = {random[i].from, random[i].to, i % 10};
+        if (cds_add_weighted_edge(g, edge.from, edge.to, edge.weight)) {
+            edges[added++] = edge;
+        }
+    }
+
+    double* expected = malloc(sizeof(double) * nodes);
+    double* found = malloc(sizeof(double) * nodes);
+    unsigned int* preds = malloc(sizeof(unsigned int) * nodes);
+
+    reference(nodes, edges, added, 3, expected);
+
+    assert(cds_graph_sssp(g, 3, found, preds) == CDS_OK);
+    check(g, nodes, expected, found, preds, 3);
+
+    assert(cds_graph_sssp_parallel(g, 3, found, preds, 0, 4) == CDS_OK);
+    check(g, nodes, expected, found, preds, 3);
+
+    assert(cds_graph_sssp_parallel(g, 3, found, preds, 2, 3) == CDS_OK);
+    check(g, nodes, expected, found, preds, 3);
+
+    cds_destroy_graph(g);
+    free(random);
+    free(edges);
+    free(expected);
+    free(found);
+    free(preds);
+
+    printf("sssp: ok\n");
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/graph.h>
+
+#include "graph_fixture.h"
+
+// every triple of the undirected graph without self loops
+static size_t reference(int nodes, const struct cds_edge* edges, size_t count, double* coefficients) {
+    bool* adjacent = calloc((size_t) nodes * nodes, sizeof(bool));
+    size_t* through = calloc(nodes, sizeof(size_t));
+    size_t* degree = calloc(nodes, sizeof(size_t));
+    size_t total = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (edges[i].from != edges[i].to) {
+            adjacent[(size_t) edges[i].from * nodes + edges[i].to] = true;
+            adjacent[(size_t) edges[i].to * nodes + edges[i].from] = true;
+        }
+    }
+
+    for (int a = 0; a < nodes; a++) {
+        for (int b = 0; b < nodes; b++) {
+            degree[a] += adjacent[(size_t) a * nodes + b];
+        }
+    }
+
+    for (int a = 0; a < nodes; a++) {
+        for (int b = a + 1; b < nodes; b++) {
+            if (!adjacent[(size_t) a * nodes + b]) {
+                continue;
+            }
+            for (int c = b + 1; c < nodes; c++) {
+                if (adjacent[(size_t) a * nodes + c] && adjacent[(size_t) b * nodes + c]) {
+                    total++;
+                    through[a]++;
+                    through[b]++;
+                    through[c]++;
+                }
+            }
+        }
+    }
+
+    for (int node = 0; node < nodes; node++) {
+        double pairs = degree[node] * (degree[node] - 1) / 2.0;
+        coefficients[node] = degree[node] < 2 ? 0 : through[node] / pairs;
+    }
+
+    free(adjacent);
+    free(through);
+    free(degree);
+    return total;
+}
+
+static void check(cds_graph* g, size_t expected, const double* coefficients, size_t nthreads) {
+    int nodes = cds_graph_nodes(g);
+    double* computed = malloc(sizeof(double) * nodes);
+
+    assert(cds_graph_triangles(g, nthreads) == expected);
+    assert(cds_graph_clustering(g, computed, nthreads) == CDS_OK);
+    for (int node = 0; node < nodes; node++) {
+        assert(fabs(computed[node] - coefficients[node]) < 1e-12);
+    }
+
+    free(computed);
+}
+
+static void check_backends(int nodes, const struct cds_edge* edges, size_t count) {
+    double* coefficients = malloc(sizeof(double) * nodes);
+    size_t expected = reference(nodes, edges, count, coefficients);
+
+    cds_graph* graphs[FIXTURE_BACKENDS];
+    fixture_backends(nodes, edges, count, graphs);
+    for (size_t backend = 0; backend < FIXTURE_BACKENDS; backend++) {
+        check(graphs[backend], expected, coefficients, 1);
+        check(graphs[backend], expected, coefficients, 4);
+    }
+    fixture_destroy(graphs);
+
+    free(coefficients);
+}
+
+int main() {
+    // square 0-1-2-3 with diagonal 0-2 both ways, self loop and a tail
+    struct cds_edge small[] = {{0, 1}, {1, 2}, {2, 3}, {3, 0}, {0, 2}, {2, 0}, {1, 1}, {3, 4}};
+    double coefficients[5];
+    cds_graph* g = cds_create_csr_graph(5, small, 8);
+    assert(cds_graph_triangles(g, 1) == 2);
+    assert(cds_graph_clustering(g, coefficients, 1) == CDS_OK);
+    assert(coefficients[0] == 2 / 3.0 && coefficients[1] == 1 && coefficients[2] == 2 / 3.0);
+    assert(coefficients[3] == 1 / 3.0 && coefficients[4] == 0);
+    cds_destroy_graph(g);
+    check_backends(5, small, 8);
+
+    // dense enough for workers and for matrix rows over several words
+    struct cds_edge* edges = fixture_edges(600, 20000, 23);
+    check_backends(600, edges, 20000);
+    free(edges);
+
+    assert(cds_graph_triangles(NULL, 1) == SIZE_MAX);
+
+    printf("triangles: ok\n");
+    return 0;
+}
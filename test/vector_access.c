@@ -0,0 +1,57 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/vector.h>
+
+struct record {
+    int id;
+    char name[16];
+};
+
+int main() {
+    CDS_VECTOR(struct record) vector = CDS_VECTOR_NEW(struct record);
+
+    // elements are built in place
+    for (int i = 0; i < 100; i++) {
+        struct record* record = cds_vector_emplace_back(vector);
+        assert(record != NULL);
+        record->id = i;
+        snprintf(record->name, sizeof(record->name), "r%d", i);
+        assert(cds_vector_size(vector) == (size_t) i + 1);
+    }
+
+    // pointers go straight into buffer
+    struct record* data = cds_vector_data(vector);
+    for (int i = 0; i < 100; i++) {
+        struct record* record = cds_vector_ptr_at(vector, (size_t) i);
+        assert(record == &data[i] && record->id == i);
+
+        char name[16];
+        snprintf(name, sizeof(name), "r%d", i);
+        for (size_t c = 0; name[c] != '\0'; c++) {
+            assert(record->name[c] == name[c]);
+        }
+    }
+
+    // writes through pointer are seen by copies
+    ((struct record*) cds_vector_ptr_at(vector, 42))->id = -42;
+    struct record copy;
+    assert(cds_vector_at(vector, 42, &copy) == CDS_OK && copy.id == -42);
+
+    assert(cds_vector_ptr_at(vector, 100) == NULL);
+    assert(cds_vector_ptr_at(NULL, 0) == NULL);
+    assert(cds_vector_data(NULL) == NULL);
+    assert(cds_vector_emplace_back(NULL) == NULL);
+
+    // emplace is a modification
+    struct cds_iter_i iter;
+    cds_vector_iter_init(&iter, vector);
+    assert(cds_vector_emplace_back(vector) != NULL);
+    assert(!cds_iter_valid(&iter));
+
+    cds_vector_destroy(vector);
+
+    printf("vector_access: ok\n");
+    return 0;
+}
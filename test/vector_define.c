@@ -0,0 +1,71 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/vector.h>
+
+struct point {
+    double x;
+    double y;
+};
+
+CDS_VECTOR_DEFINE(int, int_vector)
+CDS_VECTOR_DEFINE(struct point, point_vector)
+
+int main() {
+    int_vector numbers = int_vector_create(2);
+    assert(numbers != NULL && int_vector_size(numbers) == 0);
+
+    // pushes grow past initial capacity
+    for (int i = 0; i < 1000; i++) {
+        assert(int_vector_push(numbers, i * 3) == CDS_OK);
+    }
+    assert(int_vector_size(numbers) == 1000);
+    for (int i = 0; i < 1000; i++) {
+        assert(int_vector_at(numbers, (size_t) i) == i * 3);
+        assert(int_vector_data(numbers)[i] == i * 3);
+    }
+
+    int_vector_set(numbers, 10, -1);
+    assert(int_vector_at(numbers, 10) == -1);
+
+    // same vector through generic functions
+    cds_vector generic = int_vector_vector(numbers);
+    int value;
+    assert(cds_vector_size(generic) == 1000);
+    assert(cds_vector_at(generic, 10, &value) == CDS_OK && value == -1);
+    value = 7;
+    assert(cds_vector_pushback(generic, &value) == CDS_OK);
+    assert(int_vector_size(numbers) == 1001 && int_vector_at(numbers, 1000) == 7);
+
+    // pops come back in reverse, empty vector fails
+    assert(int_vector_pop(numbers, &value) == CDS_OK && value == 7);
+    for (int i = 999; i >= 0; i--) {
+        assert(int_vector_pop(numbers, i % 2 == 0 ? &value : NULL) == CDS_OK);
+        assert(i % 2 != 0 || value == (i == 10 ? -1 : i * 3));
+    }
+    assert(int_vector_pop(numbers, &value) == CDS_ERR);
+
+    // iterators see pushes as modifications
+    struct cds_iter_i iter;
+    cds_vector_iter_init(&iter, generic);
+    int_vector_push(numbers, 1);
+    assert(!cds_iter_valid(&iter));
+
+    int_vector_destroy(numbers);
+
+    // structs are copied by value
+    point_vector points = point_vector_create(0);
+    assert(points != NULL);
+    for (int i = 0; i < 50; i++) {
+        assert(point_vector_push(points, (struct point) {.x = i, .y = -i}) == CDS_OK);
+    }
+    struct point point = point_vector_at(points, 49);
+    assert(point.x == 49 && point.y == -49);
+    assert(cds_vector_at(point_vector_vector(points), 48, &point) == CDS_OK && point.x == 48);
+    assert(point_vector_data(points)[48].y == -48);
+    point_vector_destroy(points);
+
+    printf("vector_define: ok\n");
+    return 0;
+}
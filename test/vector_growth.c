@@ -0,0 +1,106 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/vector.h>
+
+// capacity a push on a full vector should lead to
+static size_t grown(size_t capacity, double factor, size_t min_capacity) {
+    size_t next = (size_t) (capacity * factor);
+    next = next < min_capacity ? min_capacity : next;
+    return next < capacity + 1 ? capacity + 1 : next;
+}
+
+// capacity a pop should lead to, following shrink policy
+static size_t shrunk(size_t capacity, size_t size, double factor, size_t min_capacity, size_t threshold) {
+    if (capacity <= min_capacity || (size != 0 && capacity / size < threshold)) {
+        return capacity;
+    }
+    size_t next = (size_t) (size * factor);
+    next = next < min_capacity ? min_capacity : next;
+    return next < capacity ? next : capacity;
+}
+
+int main() {
+    // factor must be greater than 1
+    struct cds_vector_config config = {.type = sizeof(int), .capacity = 8, .memory = cds_memory_system()};
+    config.growth_factor = 1;
+    assert(cds_vector_create(config) == NULL);
+    config.growth_factor = 0.5;
+    assert(cds_vector_create(config) == NULL);
+
+    // pushes follow growth factor and count reallocations
+    CDS_VECTOR(int) vector = CDS_VECTOR_NEW(int, .capacity = 2, .growth_factor = 1.5, .min_capacity = 4);
+    size_t capacity = 2;
+    size_t reallocs = 0;
+    for (int i = 0; i < 1000; i++) {
+        if (cds_vector_size(vector) == capacity) {
+            capacity = grown(capacity, 1.5, 4);
+            reallocs++;
+        }
+        assert(cds_vector_pushback(vector, &i) == CDS_OK);
+        assert(cds_vector_capacity(vector) == capacity && cds_vector_reallocs(vector) == reallocs);
+    }
+
+    // pops shrink once capacity is threshold times size, leaving room
+    for (int i = 999; i >= 0; i--) {
+        int value;
+        assert(cds_vector_popback(vector, &value) == CDS_OK && value == i);
+        size_t next = shrunk(capacity, cds_vector_size(vector), 1.5, 4, 4);
+        reallocs += next != capacity;
+        capacity = next;
+        assert(cds_vector_capacity(vector) == capacity && cds_vector_reallocs(vector) == reallocs);
+    }
+    assert(capacity == 4);
+    cds_vector_destroy(vector);
+
+    // push and pop around a boundary does not reallocate each time
+    vector = CDS_VECTOR_NEW(int, .shrink_threshold = 2);
+    for (int i = 0; i < 64; i++) {
+        cds_vector_pushback(vector, &i);
+    }
+    while (cds_vector_capacity(vector) == 64) {
+        cds_vector_popback(vector, NULL);
+    }
+    reallocs = cds_vector_reallocs(vector);
+    for (int i = 0; i < 100; i++) {
+        int value = i;
+        cds_vector_pushback(vector, &value);
+        cds_vector_popback(vector, NULL);
+    }
+    assert(cds_vector_reallocs(vector) == reallocs);
+
+    // grow reserves geometrically, bulk requests get what they need
+    capacity = cds_vector_capacity(vector);
+    assert(cds_vector_grow(vector, capacity - cds_vector_size(vector)) == CDS_OK);
+    assert(cds_vector_capacity(vector) == capacity);
+    assert(cds_vector_grow(vector, capacity - cds_vector_size(vector) + 1) == CDS_OK);
+    assert(cds_vector_capacity(vector) == capacity * 2);
+    assert(cds_vector_grow(vector, 10000) == CDS_OK);
+    assert(cds_vector_capacity(vector) == cds_vector_size(vector) + 10000);
+    assert(cds_vector_grow(vector, SIZE_MAX) == CDS_ERR);
+
+    // explicit shrink ignores policy
+    cds_vector_shrink(vector);
+    assert(cds_vector_capacity(vector) == cds_vector_size(vector));
+    cds_vector_destroy(vector);
+
+    // never shrink keeps capacity while popping and erasing
+    vector = CDS_VECTOR_NEW(int, .never_shrink = true);
+    for (int i = 0; i < 500; i++) {
+        cds_vector_pushback(vector, &i);
+    }
+    capacity = cds_vector_capacity(vector);
+    reallocs = cds_vector_reallocs(vector);
+    cds_vector_erase_range(vector, 10, 400);
+    cds_vector_resize(vector, 5, NULL);
+    while (cds_vector_popback(vector, NULL) == CDS_OK) {
+    }
+    assert(cds_vector_capacity(vector) == capacity && cds_vector_reallocs(vector) == reallocs);
+    cds_vector_shrink(vector);
+    assert(cds_vector_capacity(vector) == 1);
+    cds_vector_destroy(vector);
+
+    printf("vector_growth: ok\n");
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/vector.h>
+
+#include "../src/cds/vector_kernels.h"
+
+#define MAX_SIZE 1031
+
+// sums may be added in another order, only rounding may differ
+static bool close_to(double a, double b, double scale) {
+    return (isnan(a) && isnan(b)) || fabs(a - b) <= 1e-9 * (scale + 1);
+}
+
+// tier gives what scalar kernels give, on every length up to size
+static void check_tier(const struct _cds_kernels* tier, const struct _cds_kernels* scalar,
+                       const int32_t* i32, const int64_t* i64, const float* f32, const double* f64) {
+    for (size_t size = 0; size <= MAX_SIZE; size += size < 80 ? 1 : 61) {
+        // values in the tail, in the last vector and missing ones
+        size_t picks[] = {0, size / 2, size > 0 ? size - 1 : 0, size > 2 ? size - 3 : 0};
+        for (size_t p = 0; p < sizeof(picks) / sizeof(picks[0]); p++) {
+            size_t at = picks[p] < MAX_SIZE ? picks[p] : 0;
+            assert(tier->find_i32(i32, size, i32[at]) == scalar->find_i32(i32, size, i32[at]));
+            assert(tier->find_i64(i64, size, i64[at]) == scalar->find_i64(i64, size, i64[at]));
+            assert(tier->find_f32(f32, size, f32[at]) == scalar->find_f32(f32, size, f32[at]));
+            assert(tier->find_f64(f64, size, f64[at]) == scalar->find_f64(f64, size, f64[at]));
+
+            assert(tier->count_i32(i32, size, i32[at]) == scalar->count_i32(i32, size, i32[at]));
+            assert(tier->count_i64(i64, size, i64[at]) == scalar->count_i64(i64, size, i64[at]));
+            assert(tier->count_f32(f32, size, f32[at]) == scalar->count_f32(f32, size, f32[at]));
+            assert(tier->count_f64(f64, size, f64[at]) == scalar->count_f64(f64, size, f64[at]));
+        }
+        assert(tier->find_i32(i32, size, 12345) == CDS_VECTOR_NPOS);
+        assert(tier->find_i64(i64, size, INT64_MIN) == CDS_VECTOR_NPOS);
+        assert(tier->find_f64(f64, size, NAN) == CDS_VECTOR_NPOS && tier->count_f32(f32, size, NAN) == 0);
+
+        assert(tier->min_i32(i32, size) == scalar->min_i32(i32, size));
+        assert(tier->min_i64(i64, size) == scalar->min_i64(i64, size));
+        assert(tier->min_f32(f32, size) == scalar->min_f32(f32, size));
+        assert(tier->min_f64(f64, size) == scalar->min_f64(f64, size));
+
+        assert(tier->max_i32(i32, size) == scalar->max_i32(i32, size));
+        assert(tier->max_i64(i64, size) == scalar->max_i64(i64, size));
+        assert(tier->max_f32(f32, size) == scalar->max_f32(f32, size));
+        assert(tier->max_f64(f64, size) == scalar->max_f64(f64, size));
+
+        assert(tier->sum_i32(i32, size) == scalar->sum_i32(i32, size));
+        assert(tier->sum_i64(i64, size) == scalar->sum_i64(i64, size));
+        assert(close_to(tier->sum_f32(f32, size), scalar->sum_f32(f32, size), 1e6 * (double) size));
+        assert(close_to(tier->sum_f64(f64, size), scalar->sum_f64(f64, size), 1e6 * (double) size));
+    }
+}
+
+int main() {
+    static int32_t i32[MAX_SIZE];
+    static int64_t i64[MAX_SIZE];
+    static float f32[MAX_SIZE];
+    static double f64[MAX_SIZE];
+    srand(8);
+
+    // negatives, repeats, extremes and NaNs which min/max skip, sums only
+    // see NaNs past first half
+    for (size_t i = 0; i < MAX_SIZE; i++) {
+        i32[i] = rand() % 64 == 0 ? (rand() % 2 ? INT32_MIN : INT32_MAX) : rand() % 2001 - 1000;
+        i64[i] = rand() % 64 == 0 ? (int64_t) (rand() % 4096) << 40 : (int64_t) (rand() % 2001 - 1000) * ((int64_t) 1 << 33);
+        f64[i] = i > MAX_SIZE / 2 && rand() % 97 == 0 ? NAN : (double) (rand() % 2000001 - 1000000) / 3.0;
+        f32[i] = (float) f64[i];
+    }
+    i64[MAX_SIZE - 1] = INT64_MAX;
+    i32[MAX_SIZE - 2] = -5000;
+
+    const struct _cds_kernels* scalar = _cds_kernels_tier(_CDS_KERNELS_SCALAR);
+    assert(scalar != NULL);
+#if defined(__GNUC__) && defined(__x86_64__)
+    assert(_cds_kernels_tier(_CDS_KERNELS_SSE2) != NULL);
+#endif
+
+    size_t tested = 0;
+    for (int tier = 0; tier < _CDS_KERNELS_TIERS; tier++) {
+        const struct _cds_kernels* kernels = _cds_kernels_tier((enum _cds_kernel_tier) tier);
+        if (kernels != NULL) {
+            check_tier(kernels, scalar, i32, i64, f32, f64);
+            tested++;
+        }
+    }
+    assert(tested >= 1);
+
+    // public functions go through a tier, element size is checked
+    CDS_VECTOR(int32_t) vector = CDS_VECTOR_NEW(int32_t);
+    cds_vector_append_n(vector, i32, MAX_SIZE);
+    int32_t found;
+    int64_t sum;
+    assert(cds_vector_find_i32(vector, i32[777]) == scalar->find_i32(i32, MAX_SIZE, i32[777]));
+    assert(cds_vector_count_i32(vector, i32[5]) == scalar->count_i32(i32, MAX_SIZE, i32[5]));
+    assert(cds_vector_min_i32(vector, &found) == CDS_OK && found == INT32_MIN);
+    assert(cds_vector_max_i32(vector, &found) == CDS_OK && found == INT32_MAX);
+    assert(cds_vector_sum_i32(vector, &sum) == CDS_OK && sum == scalar->sum_i32(i32, MAX_SIZE));
+    assert(cds_vector_find_i64(vector, 0) == CDS_VECTOR_NPOS && cds_vector_min_i64(vector, &sum) == CDS_ERR);
+
+    cds_vector_clear(vector);
+    assert(cds_vector_min_i32(vector, &found) == CDS_ERR);
+    assert(cds_vector_sum_i32(vector, &sum) == CDS_OK && sum == 0);
+    cds_vector_destroy(vector);
+
+    printf("vector_kernels: ok\n");
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/vector.h>
+
+#define PATH "/tmp/cds_vector_mapped_test.bin"
+#define COUNT 10000
+
+// overwrite bytes of saved file at given offset
+static void corrupt(size_t offset, const void* bytes, size_t count) {
+    FILE* file = fopen(PATH, "r+b");
+    assert(file != NULL);
+    assert(fseek(file, (long) offset, SEEK_SET) == 0);
+    assert(fwrite(bytes, 1, count, file) == count);
+    fclose(file);
+}
+
+// mapped vector holds what was saved
+static void check(CDS_VECTOR(int64_t) vector) {
+    assert(vector != NULL && cds_vector_size(vector) == COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        assert(*(int64_t*) cds_vector_ptr_at(vector, i) == (int64_t) i * 3 - 7);
+    }
+}
+
+int main() {
+    CDS_VECTOR(int64_t) vector = CDS_VECTOR_NEW(int64_t, .alignment = 64);
+    for (size_t i = 0; i < COUNT; i++) {
+        int64_t value = (int64_t) i * 3 - 7;
+        cds_vector_pushback(vector, &value);
+    }
+    assert(cds_vector_save(vector, PATH) == CDS_OK);
+    assert(!cds_vector_readonly(vector));
+
+    // read-only mapping, elements and iterators work
+    CDS_VECTOR(int64_t) mapped = cds_vector_open_mapped(PATH, CDS_VECTOR_MAP_READ | CDS_VECTOR_MAP_VERIFY);
+    check(mapped);
+    assert(cds_vector_readonly(mapped));
+    assert((uintptr_t) cds_vector_data(mapped) % 64 == 0);
+    int64_t sum = 0;
+    CDS_VECTOR_LOOP(mapped, int64_t*, value, {
+        sum += *value;
+    });
+    assert(sum == (int64_t) COUNT * (COUNT - 1) / 2 * 3 - 7 * COUNT);
+
+    // every write is rejected
+    int64_t value = 1;
+    assert(cds_vector_pushback(mapped, &value) == CDS_ERR);
+    assert(cds_vector_emplace_back(mapped) == NULL);
+    assert(cds_vector_insert(mapped, 0, &value) == CDS_ERR);
+    assert(cds_vector_append_n(mapped, &value, 1) == CDS_ERR);
+    assert(cds_vector_erase(mapped, 0) == CDS_ERR);
+    assert(cds_vector_erase_range(mapped, 0, 2) == CDS_ERR);
+    assert(cds_vector_resize(mapped, COUNT * 2, NULL) == CDS_ERR);
+    assert(cds_vector_reserve(mapped, COUNT * 2) == CDS_ERR);
+    assert(cds_vector_radix_sort(mapped, CDS_VECTOR_KEY_I64, 0, 1) == CDS_ERR);
+    check(mapped);
+    cds_vector_destroy(mapped);
+
+    // copy on write mapping can change, file stays as it was
+    mapped = cds_vector_open_mapped(PATH, CDS_VECTOR_MAP_COPY);
+    check(mapped);
+    assert(!cds_vector_readonly(mapped));
+    *(int64_t*) cds_vector_ptr_at(mapped, 0) = 100;
+    for (int i = 0; i < 100; i++) {
+        assert(cds_vector_pushback(mapped, &value) == CDS_OK);
+    }
+    assert(cds_vector_size(mapped) == COUNT + 100 && *(int64_t*) cds_vector_ptr_at(mapped, 0) == 100);
+    cds_vector_destroy(mapped);
+
+    mapped = cds_vector_open_mapped(PATH, CDS_VECTOR_MAP_VERIFY);
+    check(mapped);
+    cds_vector_destroy(mapped);
+
+    // saving again replaces file
+    cds_vector_resize(vector, 10, NULL);
+    assert(cds_vector_save(vector, PATH) == CDS_OK);
+    mapped = cds_vector_open_mapped(PATH, CDS_VECTOR_MAP_READ);
+    assert(mapped != NULL && cds_vector_size(mapped) == 10);
+    cds_vector_destroy(mapped);
+    cds_vector_resize(vector, 0, NULL);
+    assert(cds_vector_save(vector, PATH) == CDS_OK);
+    mapped = cds_vector_open_mapped(PATH, CDS_VECTOR_MAP_VERIFY);
+    assert(mapped != NULL && cds_vector_empty(mapped));
+    cds_vector_destroy(mapped);
+
+    // corrupted data is only caught when verifying
+    for (size_t i = 0; i < COUNT; i++) {
+        int64_t element = (int64_t) i * 3 - 7;
+        cds_vector_pushback(vector, &element);
+    }
+    assert(cds_vector_save(vector, PATH) == CDS_OK);
+    corrupt(4096 + 8 * 500, "\xff", 1);
+    mapped = cds_vector_open_mapped(PATH, CDS_VECTOR_MAP_READ);
+    assert(mapped != NULL);
+    cds_vector_destroy(mapped);
+    assert(cds_vector_open_mapped(PATH, CDS_VECTOR_MAP_VERIFY) == NULL);
+
+    // corrupted checksum fails the same way
+    assert(cds_vector_save(vector, PATH) == CDS_OK);
+    corrupt(40, "\x01\x02", 2);
+    mapped = cds_vector_open_mapped(PATH, CDS_VECTOR_MAP_READ);
+    assert(mapped != NULL);
+    cds_vector_destroy(mapped);
+    assert(cds_vector_open_mapped(PATH, CDS_VECTOR_MAP_VERIFY | CDS_VECTOR_MAP_COPY) == NULL);
+
+    // broken header is never accepted
+    uint64_t huge_size = UINT64_MAX / 8;
+    assert(cds_vector_save(vector, PATH) == CDS_OK);
+    corrupt(24, &huge_size, sizeof(huge_size));
+    assert(cds_vector_open_mapped(PATH, CDS_VECTOR_MAP_READ) == NULL);
+
+    assert(cds_vector_save(vector, PATH) == CDS_OK);
+    corrupt(0, "XDSVEC", 6);
+    assert(cds_vector_open_mapped(PATH, CDS_VECTOR_MAP_READ) == NULL);
+
+    uint32_t version = 99;
+    assert(cds_vector_save(vector, PATH) == CDS_OK);
+    corrupt(8, &version, sizeof(version));
+    assert(cds_vector_open_mapped(PATH, CDS_VECTOR_MAP_READ) == NULL);
+
+    uint64_t type = 0;
+    assert(cds_vector_save(vector, PATH) == CDS_OK);
+    corrupt(16, &type, sizeof(type));
+    assert(cds_vector_open_mapped(PATH, CDS_VECTOR_MAP_READ) == NULL);
+
+    // truncated files and missing ones
+    FILE* file = fopen(PATH, "wb");
+    fwrite("CDSVEC", 1, 7, file);
+    fclose(file);
+    assert(cds_vector_open_mapped(PATH, CDS_VECTOR_MAP_READ) == NULL);
+    remove(PATH);
+    assert(cds_vector_open_mapped(PATH, CDS_VECTOR_MAP_READ) == NULL);
+    assert(cds_vector_save(vector, "/tmp/cds_missing_directory/vector.bin") == CDS_ERR);
+
+    cds_vector_destroy(vector);
+
+    printf("vector_mapped: ok\n");
+    return 0;
+}
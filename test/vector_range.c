@@ -0,0 +1,86 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/vector.h>
+
+// vector holds exactly given values
+static void check(CDS_VECTOR(int) vector, const int* values, size_t count) {
+    assert(cds_vector_size(vector) == count);
+    for (size_t i = 0; i < count; i++) {
+        int value;
+        assert(cds_vector_at(vector, i, &value) == CDS_OK);
+        assert(value == values[i]);
+    }
+}
+
+int main() {
+    CDS_VECTOR(int) vector = CDS_VECTOR_NEW(int);
+    int values[100];
+    for (int i = 0; i < 100; i++) {
+        values[i] = i;
+    }
+
+    // append grows past capacity in one call
+    assert(cds_vector_append_n(vector, values, 30) == CDS_OK);
+    check(vector, values, 30);
+    assert(cds_vector_append_n(vector, NULL, 0) == CDS_OK);
+    assert(cds_vector_append_n(vector, NULL, 1) == CDS_ERR);
+
+    // insert at front, middle and end
+    int head[3] = {-3, -2, -1};
+    int middle[2] = {100, 101};
+    int tail[4] = {30, 31, 32, 33};
+    assert(cds_vector_insert_range(vector, 0, head, 3) == CDS_OK);
+    assert(cds_vector_insert_range(vector, 13, middle, 2) == CDS_OK);
+    assert(cds_vector_insert_range(vector, cds_vector_size(vector), tail, 4) == CDS_OK);
+    assert(cds_vector_insert_range(vector, cds_vector_size(vector) + 1, tail, 1) == CDS_ERR);
+    assert(cds_vector_insert_range(vector, 5, tail, 0) == CDS_OK);
+
+    int expected[39];
+    size_t count = 0;
+    for (int i = -3; i < 10; i++) {
+        expected[count++] = i;
+    }
+    expected[count++] = 100;
+    expected[count++] = 101;
+    for (int i = 10; i < 34; i++) {
+        expected[count++] = i;
+    }
+    check(vector, expected, count);
+
+    // erase ranges back to where it started
+    assert(cds_vector_erase_range(vector, 13, 15) == CDS_OK);
+    assert(cds_vector_erase_range(vector, 0, 3) == CDS_OK);
+    assert(cds_vector_erase_range(vector, 30, 34) == CDS_OK);
+    check(vector, values, 30);
+
+    // empty and bad ranges
+    assert(cds_vector_erase_range(vector, 7, 7) == CDS_OK);
+    assert(cds_vector_erase_range(vector, 8, 7) == CDS_ERR);
+    assert(cds_vector_erase_range(vector, 0, 31) == CDS_ERR);
+    check(vector, values, 30);
+
+    // middle range, then everything
+    assert(cds_vector_erase_range(vector, 10, 20) == CDS_OK);
+    for (int i = 0; i < 20; i++) {
+        int value;
+        cds_vector_at(vector, (size_t) i, &value);
+        assert(value == (i < 10 ? i : i + 10));
+    }
+    assert(cds_vector_erase_range(vector, 0, cds_vector_size(vector)) == CDS_OK);
+    assert(cds_vector_empty(vector));
+
+    // inserting a bulk into an empty vector
+    assert(cds_vector_insert_range(vector, 0, values, 100) == CDS_OK);
+    check(vector, values, 100);
+
+    assert(cds_vector_append_n(NULL, values, 1) == CDS_ERR);
+    assert(cds_vector_insert_range(NULL, 0, values, 1) == CDS_ERR);
+    assert(cds_vector_erase_range(NULL, 0, 0) == CDS_ERR);
+
+    cds_vector_destroy(vector);
+
+    printf("vector_range: ok\n");
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/vector.h>
+
+// record sorted by key, position tells if sort was stable
+struct record {
+    uint32_t position;
+    int64_t key;
+};
+
+static int cmp_i32(const void* a, const void* b) {
+    int32_t x = *(const int32_t*) a;
+    int32_t y = *(const int32_t*) b;
+    return (x > y) - (x < y);
+}
+
+static int cmp_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*) a;
+    uint32_t y = *(const uint32_t*) b;
+    return (x > y) - (x < y);
+}
+
+static int cmp_i64(const void* a, const void* b) {
+    int64_t x = *(const int64_t*) a;
+    int64_t y = *(const int64_t*) b;
+    return (x > y) - (x < y);
+}
+
+static int cmp_f32(const void* a, const void* b) {
+    float x = *(const float*) a;
+    float y = *(const float*) b;
+    return (x > y) - (x < y);
+}
+
+static int cmp_f64(const void* a, const void* b) {
+    double x = *(const double*) a;
+    double y = *(const double*) b;
+    return (x > y) - (x < y);
+}
+
+// random value, small ranges give many duplicates
+static int64_t random_value(size_t range) {
+    int64_t value = ((int64_t) rand() << 31) ^ rand();
+    return range != 0 ? (int64_t) (value % (int64_t) range) - (int64_t) range / 2 : value - (INT64_C(1) << 61);
+}
+
+// vector sorted by both entry points matches qsort
+static void check_i32(size_t size, size_t range, size_t nthreads) {
+    CDS_VECTOR(int32_t) comparison = CDS_VECTOR_NEW(int32_t);
+    CDS_VECTOR(int32_t) radix = CDS_VECTOR_NEW(int32_t);
+    int32_t* reference = malloc(sizeof(int32_t) * (size + 1));
+
+    for (size_t i = 0; i < size; i++) {
+        reference[i] = (int32_t) random_value(range);
+    }
+    cds_vector_append_n(comparison, reference, size);
+    cds_vector_append_n(radix, reference, size);
+    qsort(reference, size, sizeof(int32_t), cmp_i32);
+
+    assert(cds_vector_sort_parallel(comparison, cmp_i32, nthreads) == CDS_OK);
+    assert(cds_vector_radix_sort(radix, CDS_VECTOR_KEY_I32, 0, nthreads) == CDS_OK);
+    assert(cds_vector_size(comparison) == size && cds_vector_size(radix) == size);
+    assert(size == 0 || memcmp(cds_vector_data(comparison), reference, sizeof(int32_t) * size) == 0);
+    assert(size == 0 || memcmp(cds_vector_data(radix), reference, sizeof(int32_t) * size) == 0);
+
+    // unsigned keys put negatives last
+    qsort(reference, size, sizeof(uint32_t), cmp_u32);
+    assert(cds_vector_radix_sort(radix, CDS_VECTOR_KEY_U32, 0, nthreads) == CDS_OK);
+    assert(size == 0 || memcmp(cds_vector_data(radix), reference, sizeof(uint32_t) * size) == 0);
+
+    free(reference);
+    cds_vector_destroy(comparison);
+    cds_vector_destroy(radix);
+}
+
+// floats sort like numbers, negatives included
+static void check_float(size_t size, size_t nthreads) {
+    CDS_VECTOR(float) singles = CDS_VECTOR_NEW(float);
+    CDS_VECTOR(double) doubles = CDS_VECTOR_NEW(double);
+    float* single_reference = malloc(sizeof(float) * (size + 1));
+    double* double_reference = malloc(sizeof(double) * (size + 1));
+
+    for (size_t i = 0; i < size; i++) {
+        double_reference[i] = (double) random_value(2000) / 7.0;
+        single_reference[i] = (float) double_reference[i];
+    }
+    cds_vector_append_n(singles, single_reference, size);
+    cds_vector_append_n(doubles, double_reference, size);
+    qsort(single_reference, size, sizeof(float), cmp_f32);
+    qsort(double_reference, size, sizeof(double), cmp_f64);
+
+    assert(cds_vector_radix_sort(singles, CDS_VECTOR_KEY_F32, 0, nthreads) == CDS_OK);
+    assert(cds_vector_radix_sort(doubles, CDS_VECTOR_KEY_F64, 0, nthreads) == CDS_OK);
+    for (size_t i = 0; i < size; i++) {
+        assert(((float*) cds_vector_data(singles))[i] == single_reference[i]);
+        assert(((double*) cds_vector_data(doubles))[i] == double_reference[i]);
+    }
+
+    assert(cds_vector_sort_parallel(doubles, cmp_f64, nthreads) == CDS_OK);
+    for (size_t i = 0; i < size; i++) {
+        assert(((double*) cds_vector_data(doubles))[i] == double_reference[i]);
+    }
+
+    free(single_reference);
+    free(double_reference);
+    cds_vector_destroy(singles);
+    cds_vector_destroy(doubles);
+}
+
+// records sorted by a field keep order of equal keys
+static void check_records(size_t size, size_t range, size_t nthreads) {
+    CDS_VECTOR(struct record) records = CDS_VECTOR_NEW(struct record);
+    int64_t* keys = malloc(sizeof(int64_t) * (size + 1));
+
+    for (size_t i = 0; i < size; i++) {
+        struct record* record = cds_vector_emplace_back(records);
+        record->position = (uint32_t) i;
+        record->key = random_value(range);
+        keys[i] = record->key;
+    }
+    qsort(keys, size, sizeof(int64_t), cmp_i64);
+
+    assert(cds_vector_radix_sort(records, CDS_VECTOR_KEY_I64, offsetof(struct record, key), nthreads) == CDS_OK);
+    struct record* data = cds_vector_data(records);
+    for (size_t i = 0; i < size; i++) {
+        assert(data[i].key == keys[i]);
+        assert(i == 0 || data[i - 1].key != data[i].key || data[i - 1].position < data[i].position);
+    }
+
+    // key must fit inside element
+    assert(cds_vector_radix_sort(records, CDS_VECTOR_KEY_I64, sizeof(struct record) - 4, nthreads) == CDS_ERR);
+    assert(cds_vector_radix_sort(records, CDS_VECTOR_KEY_U32, sizeof(struct record) + 1, nthreads) == CDS_ERR);
+
+    free(keys);
+    cds_vector_destroy(records);
+}
+
+int main() {
+    srand(13);
+
+    // both sides of the parallel threshold, empty and single vectors too
+    size_t sizes[] = {0, 1, 2, 7, 1000, 16383, 16384, 16385, 70001};
+    size_t threads[] = {1, 4};
+
+    for (size_t t = 0; t < 2; t++) {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            check_i32(sizes[s], 0, threads[t]);
+            check_i32(sizes[s], 50, threads[t]);
+            check_float(sizes[s], threads[t]);
+            check_records(sizes[s], 100, threads[t]);
+        }
+    }
+
+    // default sort picks threads on its own
+    CDS_VECTOR(int32_t) vector = CDS_VECTOR_NEW(int32_t);
+    for (int32_t i = 40000; i > -40000; i--) {
+        cds_vector_pushback(vector, &i);
+    }
+    assert(cds_vector_sort(vector, cmp_i32) == CDS_OK);
+    for (size_t i = 0; i < cds_vector_size(vector); i++) {
+        assert(((int32_t*) cds_vector_data(vector))[i] == (int32_t) i - 39999);
+    }
+
+    // sorting is a modification
+    struct cds_iter_i iter;
+    cds_vector_iter_init(&iter, vector);
+    assert(cds_vector_radix_sort(vector, CDS_VECTOR_KEY_I32, 0, 4) == CDS_OK);
+    assert(!cds_iter_valid(&iter));
+
+    assert(cds_vector_sort_parallel(vector, NULL, 1) == CDS_ERR);
+    assert(cds_vector_sort_parallel(NULL, cmp_i32, 1) == CDS_ERR);
+    assert(cds_vector_radix_sort(NULL, CDS_VECTOR_KEY_I32, 0, 1) == CDS_ERR);
+    cds_vector_destroy(vector);
+
+    printf("vector_sort: ok\n");
+    return 0;
+}
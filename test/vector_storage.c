@@ -0,0 +1,106 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/arena.h>
+#include <cds/vector.h>
+
+#define HUGE_PAGE ((size_t) 2 << 20)
+
+// data stays aligned and keeps every element
+static void check(CDS_VECTOR(int64_t) vector, size_t alignment) {
+    int64_t* data = cds_vector_data(vector);
+    assert((uintptr_t) data % alignment == 0);
+    for (size_t i = 0; i < cds_vector_size(vector); i++) {
+        assert(data[i] == (int64_t) i);
+    }
+}
+
+// pushes and pops checking alignment after every reallocation
+static void exercise(CDS_VECTOR(int64_t) vector, size_t alignment, size_t count) {
+    size_t reallocs = cds_vector_reallocs(vector);
+    check(vector, alignment);
+
+    for (size_t i = 0; i < count; i++) {
+        int64_t value = (int64_t) cds_vector_size(vector);
+        assert(cds_vector_pushback(vector, &value) == CDS_OK);
+        if (cds_vector_reallocs(vector) != reallocs) {
+            reallocs = cds_vector_reallocs(vector);
+            check(vector, alignment);
+        }
+    }
+    check(vector, alignment);
+
+    while (cds_vector_size(vector) > 1) {
+        assert(cds_vector_popback(vector, NULL) == CDS_OK);
+        if (cds_vector_reallocs(vector) != reallocs) {
+            reallocs = cds_vector_reallocs(vector);
+            check(vector, alignment);
+        }
+    }
+    assert(reallocs > 2);
+
+    // explicit reserve and shrink too
+    assert(cds_vector_reserve(vector, count) == CDS_OK);
+    check(vector, alignment);
+    cds_vector_shrink(vector);
+    check(vector, alignment);
+    assert(cds_vector_capacity(vector) == 1);
+}
+
+int main() {
+    // alignment must be a power of two and supported by memory manager
+    struct cds_vector_config config = {.type = sizeof(int64_t), .capacity = 8, .memory = cds_memory_system(), .alignment = 48};
+    assert(cds_vector_create(config) == NULL);
+    config.alignment = 64;
+    config.memory.aligned_allocator = NULL;
+    assert(cds_vector_create(config) == NULL);
+
+    size_t alignments[] = {64, 256, 4096};
+    for (size_t a = 0; a < sizeof(alignments) / sizeof(alignments[0]); a++) {
+        CDS_VECTOR(int64_t) vector = CDS_VECTOR_NEW(int64_t, .capacity = 1, .alignment = alignments[a]);
+        assert(vector != NULL);
+        exercise(vector, alignments[a], 5000);
+
+        // copies keep alignment
+        CDS_VECTOR(int64_t) copy = cds_vector_copy(vector, cds_memory_system());
+        check(copy, alignments[a]);
+        int64_t value = 1;
+        cds_vector_pushback(copy, &value);
+        cds_vector_popback(copy, NULL);
+        check(copy, alignments[a]);
+
+        cds_vector_destroy(copy);
+        cds_vector_destroy(vector);
+    }
+
+    // aligned buffers can come from an arena
+    cds_arena arena = cds_arena_create(1 << 16, cds_memory_system());
+    CDS_VECTOR(int64_t) arena_vector = cds_vector_create((struct cds_vector_config) {
+        .type = sizeof(int64_t), .capacity = 1, .memory = cds_memory_arena(arena), .alignment = 128
+    });
+    assert(arena_vector != NULL);
+    exercise(arena_vector, 128, 3000);
+    cds_vector_destroy(arena_vector);
+    cds_arena_destroy(arena);
+
+    // huge pages once buffer reaches 2 MiB, back to heap when it shrinks
+    CDS_VECTOR(int64_t) huge = CDS_VECTOR_NEW(int64_t, .huge_pages = true, .alignment = 64);
+    assert(huge != NULL);
+    size_t reallocs = 0;
+    for (size_t i = 0; i < HUGE_PAGE; i++) {
+        int64_t value = (int64_t) i;
+        assert(cds_vector_pushback(huge, &value) == CDS_OK);
+        if (cds_vector_reallocs(huge) != reallocs) {
+            reallocs = cds_vector_reallocs(huge);
+            bool big = cds_vector_capacity(huge) * sizeof(int64_t) >= HUGE_PAGE;
+            check(huge, big ? HUGE_PAGE : 64);
+        }
+    }
+    exercise(huge, 64, HUGE_PAGE / 4);
+    cds_vector_destroy(huge);
+
+    printf("vector_storage: ok\n");
+    return 0;
+}
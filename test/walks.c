@@ -0,0 +1,104 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/graph.h>
+#include <cds/vector.h>
+
+#include "graph_fixture.h"
+
+// every step is an edge until a node without out-edges, then padding only
+static void check_walks(cds_graph* g, struct cds_graph_walk_config config, CDS_VECTOR(unsigned int) walks) {
+    size_t nodes = cds_graph_nodes(g);
+    const unsigned int* ids = cds_vector_data(walks);
+
+    assert(cds_vector_size(walks) == nodes * config.walks_per_node * config.length);
+
+    for (size_t walk = 0; walk < nodes * config.walks_per_node; walk++) {
+        const unsigned int* steps = &ids[walk * config.length];
+        assert(steps[0] == walk % nodes);
+
+        for (size_t step = 1; step < config.length; step++) {
+            if (steps[step - 1] == CDS_GRAPH_UNREACHED || cds_graph_out_degree(g, steps[step - 1]) == 0) {
+                assert(steps[step] == CDS_GRAPH_UNREACHED);
+            } else {
+                assert(cds_has_edge(g, steps[step - 1], steps[step]));
+            }
+        }
+    }
+}
+
+static CDS_VECTOR(unsigned int) generate(cds_graph* g, struct cds_graph_walk_config config) {
+    CDS_VECTOR(unsigned int) walks = CDS_VECTOR_NEW(unsigned int);
+    assert(cds_graph_random_walks(g, config, walks) == CDS_OK);
+    check_walks(g, config, walks);
+    return walks;
+}
+
+static bool same(CDS_VECTOR(unsigned int) a, CDS_VECTOR(unsigned int) b) {
+    return cds_vector_size(a) == cds_vector_size(b)
+        && memcmp(cds_vector_data(a), cds_vector_data(b), sizeof(unsigned int) * cds_vector_size(a)) == 0;
+}
+
+int main() {
+    // weighted graph with dead ends, enough steps for workers
+    int nodes = 1000;
+    struct cds_edge* edges = fixture_edges(nodes, 4000, 24);
+    cds_graph* g = cds_create_list_graph(nodes);
+    for (size_t i = 0; i < 4000; i++) {
+        if (edges[i].from % 10 != 0) {
+            cds_add_weighted_edge(g, edges[i].from, edges[i].to, 1 + i % 5);
+        }
+    }
+    free(edges);
+
+    enum cds_graph_walk kinds[] = {CDS_GRAPH_WALK_UNIFORM, CDS_GRAPH_WALK_WEIGHTED, CDS_GRAPH_WALK_NODE2VEC};
+    for (size_t kind = 0; kind < 3; kind++) {
+        struct cds_graph_walk_config config = {
+            .kind = kinds[kind], .length = 10, .walks_per_node = 10, .p = 0.5, .q = 2, .seed = 24, .nthreads = 1
+        };
+
+        CDS_VECTOR(unsigned int) serial = generate(g, config);
+        config.nthreads = 4;
+        CDS_VECTOR(unsigned int) parallel = generate(g, config);
+        config.seed = 25;
+        CDS_VECTOR(unsigned int) reseeded = generate(g, config);
+
+        // same seed, same walks for any thread count
+        assert(same(serial, parallel) && !same(serial, reseeded));
+
+        cds_vector_destroy(serial);
+        cds_vector_destroy(parallel);
+        cds_vector_destroy(reseeded);
+    }
+
+    CDS_VECTOR(unsigned int) walks = CDS_VECTOR_NEW(unsigned int);
+    struct cds_graph_walk_config invalid = {.kind = CDS_GRAPH_WALK_UNIFORM, .length = 0, .walks_per_node = 1};
+    assert(cds_graph_random_walks(g, invalid, walks) == CDS_ERR);
+    invalid = (struct cds_graph_walk_config) {.kind = CDS_GRAPH_WALK_NODE2VEC, .length = 4, .walks_per_node = 1, .q = 1};
+    assert(cds_graph_random_walks(g, invalid, walks) == CDS_ERR);
+    cds_destroy_graph(g);
+
+    // 0 goes to 2 three times as often as to 1
+    g = cds_create_list_graph(3);
+    cds_add_weighted_edge(g, 0, 1, 1);
+    cds_add_weighted_edge(g, 0, 2, 3);
+    struct cds_graph_walk_config config = {.kind = CDS_GRAPH_WALK_WEIGHTED, .length = 2, .walks_per_node = 20000, .seed = 1};
+    assert(cds_graph_random_walks(g, config, walks) == CDS_OK);
+    check_walks(g, config, walks);
+
+    const unsigned int* ids = cds_vector_data(walks);
+    size_t heavy = 0, total = 0;
+    for (size_t walk = 0; walk < 3 * config.walks_per_node; walk += 3) {
+        heavy += ids[walk * 2 + 1] == 2;
+        total++;
+    }
+    assert(heavy > total * 0.72 && heavy < total * 0.78);
+
+    cds_vector_destroy(walks);
+    cds_destroy_graph(g);
+
+    printf("walks: ok\n");
+    return 0;
+}